@@ -35,6 +35,8 @@ void Assets::loadAssets(const std::string &filename)
             addSound(name, filename);
         }
     }
+
+    m_atlas.build(m_textures);
 }
 Assets::~Assets()
 {
@@ -75,6 +77,16 @@ const sf::Texture &Assets::getTexture(const std::string &name) const
     return it->second;
 }
 
+TextureRegion Assets::getTextureRegion(const std::string &name) const
+{
+    if (const TextureRegion* region = m_atlas.find(name))
+    {
+        return *region;
+    }
+    const sf::Texture& texture = getTexture(name);
+    return {&texture, sf::IntRect(0, 0, static_cast<int>(texture.getSize().x), static_cast<int>(texture.getSize().y))};
+}
+
 void Assets::addFont(const std::string &name, const std::string &filename)
 {
     sf::Font font;
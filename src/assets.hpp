@@ -5,6 +5,7 @@
 #include <SFML/Audio.hpp>
 #include "animation.hpp"
 #include "graphics/shader_manager.hpp"
+#include "graphics/texture_atlas.hpp"
 
 class Assets {
     std::map<std::string, sf::Texture> m_textures;
@@ -12,6 +13,7 @@ class Assets {
     std::map<std::string, sf::SoundBuffer> m_soundBuffers;
     std::map<std::string, Animation> m_animations;
     ShaderManager m_shaderManager;
+    TextureAtlas m_atlas; // small textures packed at load, see getTextureRegion()
 
     void addTexture(const std::string &name, const std::string &filename);
     void addFont(const std::string &name, const std::string &filename);
@@ -25,6 +27,9 @@ public:
     void loadAssets(const std::string &filename);
     
     const sf::Texture& getTexture(const std::string &name) const;
+    // Where to draw a texture from: its atlas page region when packed, otherwise the whole
+    // standalone texture. Prefer this for world sprites so they share pages.
+    TextureRegion getTextureRegion(const std::string &name) const;
     const sf::Font& getFont(const std::string &name) const;
     const sf::SoundBuffer& getSoundBuffer(const std::string &name) const;
     sf::Shader* getShader(const std::string &name);
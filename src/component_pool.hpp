@@ -0,0 +1,232 @@
+#pragma once
+#include "components/component_registry.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Type-erased interface so EntityManager can drop every component of a dead entity
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() {}
+
+    virtual bool has(size_t entityId) const = 0;
+    virtual void remove(size_t entityId) = 0;
+    virtual size_t size() const = 0;
+    virtual const std::vector<size_t>& entities() const = 0;
+    virtual void trimChangeLog(uint32_t keepFrom) = 0;
+};
+
+// Sparse-set storage for one component type
+// - m_sparse maps entity id -> index into the packed arrays
+// - m_entities and the component pages are packed, so walking every component of this type is a linear scan
+// Components live in fixed-size pages that are never reallocated or moved: creating one is a
+// placement-new at the end of the last page, and tearing the pool down frees a handful of pages.
+// Pointers returned by get()/emplace() stay valid until that component (or the last one, which
+// fills the hole) is removed
+//
+// Change tracking: every component carries the change tick it was last modified at. modify()
+// and emplace() stamp it with EntityManager's current tick and append the entity to a short
+// change log, so eachChangedSince() only visits components that actually changed. get() and
+// raw iteration do not stamp anything.
+template<typename C>
+class ComponentPool : public ComponentPoolBase {
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // Roughly 16KB per page, rounded down to a power of two so indexing is a shift and a mask
+    static constexpr size_t PAGE_SIZE = std::bit_floor(std::max<size_t>(1, 16384 / sizeof(C)));
+    static constexpr size_t PAGE_SHIFT = std::countr_zero(PAGE_SIZE);
+
+    struct alignas(C) Storage {
+        unsigned char bytes[sizeof(C)];
+    };
+
+    std::vector<size_t> m_sparse;   // entity id -> dense index (npos when absent)
+    std::vector<size_t> m_entities; // dense index -> entity id
+    std::vector<std::unique_ptr<Storage[]>> m_pages; // dense index -> component, PAGE_SIZE per page
+    size_t m_size = 0;
+
+    std::vector<uint32_t> m_ticks;  // dense index -> change tick of the last modification
+    std::vector<std::pair<uint32_t, size_t>> m_changeLog; // (tick, entity id) in stamping order
+    uint32_t m_logStart = 0;        // the log holds every stamp with tick >= m_logStart
+    const uint32_t* m_clock = nullptr;
+    uint32_t m_structureVersion = 0; // bumped whenever a component is added or removed
+
+    void stamp(size_t index)
+    {
+        uint32_t tick = m_clock ? *m_clock : 0;
+        if (m_ticks[index] != tick) {
+            m_ticks[index] = tick;
+            m_changeLog.emplace_back(tick, m_entities[index]);
+        }
+    }
+
+    C* slot(size_t index) const
+    {
+        return std::launder(reinterpret_cast<C*>(m_pages[index >> PAGE_SHIFT][index & (PAGE_SIZE - 1)].bytes));
+    }
+
+public:
+    explicit ComponentPool(const uint32_t* clock = nullptr) : m_clock(clock) {}
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    ~ComponentPool() override
+    {
+        for (size_t i = 0; i < m_size; i++) {
+            slot(i)->~C();
+        }
+    }
+
+    template<typename... Args>
+    C& emplace(size_t entityId, Args&&... args)
+    {
+        if (entityId >= m_sparse.size()) {
+            m_sparse.resize(entityId + 1, npos);
+        }
+
+        // Adding a component that already exists replaces it (same as the old map assignment)
+        size_t index = m_sparse[entityId];
+        if (index != npos) {
+            *slot(index) = C(std::forward<Args>(args)...);
+            stamp(index);
+            return *slot(index);
+        }
+
+        // Pages are kept after removals, so only growth past the high-water mark allocates
+        if ((m_size >> PAGE_SHIFT) >= m_pages.size()) {
+            m_pages.push_back(std::make_unique_for_overwrite<Storage[]>(PAGE_SIZE));
+        }
+
+        C* component = new (m_pages[m_size >> PAGE_SHIFT][m_size & (PAGE_SIZE - 1)].bytes)
+            C(std::forward<Args>(args)...);
+        m_sparse[entityId] = m_size;
+        m_entities.push_back(entityId);
+        m_ticks.push_back(~0u);
+        stamp(m_size);
+        m_size++;
+        m_structureVersion++;
+        return *component;
+    }
+
+    C* get(size_t entityId)
+    {
+        if (entityId >= m_sparse.size() || m_sparse[entityId] == npos) {
+            return nullptr;
+        }
+        return slot(m_sparse[entityId]);
+    }
+
+    const C* get(size_t entityId) const
+    {
+        if (entityId >= m_sparse.size() || m_sparse[entityId] == npos) {
+            return nullptr;
+        }
+        return slot(m_sparse[entityId]);
+    }
+
+    // Mutable access that records the component as changed
+    C* modify(size_t entityId)
+    {
+        if (entityId >= m_sparse.size() || m_sparse[entityId] == npos) {
+            return nullptr;
+        }
+        stamp(m_sparse[entityId]);
+        return slot(m_sparse[entityId]);
+    }
+
+    // Calls fn(entityId) once for every component modified after tick `since`
+    // Walks only the change log when it reaches back far enough, otherwise scans the ticks
+    template<typename Fn>
+    void eachChangedSince(uint32_t since, Fn&& fn) const
+    {
+        if (since + 1 >= m_logStart) {
+            auto it = std::upper_bound(m_changeLog.begin(), m_changeLog.end(), since,
+                [](uint32_t tick, const std::pair<uint32_t, size_t>& entry) { return tick < entry.first; });
+            for (; it != m_changeLog.end(); ++it) {
+                // Older entries for a component stamped again later are skipped
+                size_t entityId = it->second;
+                if (has(entityId) && m_ticks[m_sparse[entityId]] == it->first) {
+                    fn(entityId);
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < m_size; i++) {
+            if (m_ticks[i] > since) {
+                fn(m_entities[i]);
+            }
+        }
+    }
+
+    // Drops log entries older than keepFrom; queries reaching further back fall back to a scan
+    void trimChangeLog(uint32_t keepFrom) override
+    {
+        if (keepFrom <= m_logStart) {
+            return;
+        }
+        auto it = std::lower_bound(m_changeLog.begin(), m_changeLog.end(), keepFrom,
+            [](const std::pair<uint32_t, size_t>& entry, uint32_t tick) { return entry.first < tick; });
+        m_changeLog.erase(m_changeLog.begin(), it);
+        m_logStart = keepFrom;
+    }
+
+    uint32_t structureVersion() const { return m_structureVersion; }
+
+    bool has(size_t entityId) const override
+    {
+        return entityId < m_sparse.size() && m_sparse[entityId] != npos;
+    }
+
+    // Swap-and-pop so the pages stay packed
+    void remove(size_t entityId) override
+    {
+        if (!has(entityId)) {
+            return;
+        }
+
+        size_t index = m_sparse[entityId];
+        size_t last = m_size - 1;
+        if (index != last) {
+            *slot(index) = std::move(*slot(last));
+            m_entities[index] = m_entities[last];
+            m_ticks[index] = m_ticks[last];
+            m_sparse[m_entities[index]] = index;
+        }
+        slot(last)->~C();
+        m_entities.pop_back();
+        m_ticks.pop_back();
+        m_sparse[entityId] = npos;
+        m_size--;
+        m_structureVersion++;
+    }
+
+    size_t size() const override { return m_size; }
+
+    // Packed access for linear walks over every component of this type
+    C& at(size_t index) { return *slot(index); }
+    size_t entityAt(size_t index) const { return m_entities[index]; }
+    const std::vector<size_t>& entities() const override { return m_entities; }
+
+    class iterator {
+        const ComponentPool* m_pool;
+        size_t m_index;
+
+    public:
+        iterator(const ComponentPool* pool, size_t index) : m_pool(pool), m_index(index) {}
+
+        C& operator*() const { return *m_pool->slot(m_index); }
+        C* operator->() const { return m_pool->slot(m_index); }
+        iterator& operator++() { ++m_index; return *this; }
+        bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+        bool operator==(const iterator& other) const { return m_index == other.m_index; }
+    };
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_size); }
+};
@@ -20,6 +20,8 @@
 // - CLayer: Layer-based rendering (0-4)
 // - CScriptTile: Interactive tiles that trigger actions
 // - CSave: Save point system
+// - CPath: Path following for grid movers (PathfindingService)
+// - CFlowAgent: Grid movers steered by a shared flow field
 //
 // Game Components (Game-specific logic that affects gameplay):
 // - CNPCDialogue: NPC dialogue state management
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time component registry
+// Every component class gets a dense constexpr ID from its position in ComponentList,
+// so pool lookup is a fixed array index and each entity can carry a bitmask of the
+// components it owns. Add new components to the list below (order only affects IDs).
+
+// Engine components (engine_components.hpp)
+class CLayer;
+class CMultiCell;
+class CCollision;
+class CSave;
+class CScriptTile;
+class CTransform;
+class CSprite;
+class CAnimation;
+class CBoundingBox;
+class CInput;
+class CSound;
+class CCamera;
+class CGridMovement;
+class CPath;
+class CFlowAgent;
+
+// Game components (game_components.hpp)
+class CNPCDialogue;
+class CNPCInteraction;
+class CPlayerMovement;
+class CPlayerInput;
+class CPlayerStats;
+class CPlayerInventory;
+class CPlayerState;
+class CCharacter;
+class CBattleSystem;
+class CInventory;
+class CDialogue;
+class CEncounterZone;
+class CShop;
+class CQuest;
+class CSaveData;
+
+template<typename... Ts>
+struct ComponentTypeList {
+    static constexpr size_t size = sizeof...(Ts);
+};
+
+typedef ComponentTypeList<
+    CLayer, CMultiCell, CCollision, CSave, CScriptTile, CTransform, CSprite,
+    CAnimation, CBoundingBox, CInput, CSound, CCamera, CGridMovement, CPath, CFlowAgent,
+    CNPCDialogue, CNPCInteraction, CPlayerMovement, CPlayerInput, CPlayerStats,
+    CPlayerInventory, CPlayerState, CCharacter, CBattleSystem, CInventory,
+    CDialogue, CEncounterZone, CShop, CQuest, CSaveData
+> ComponentList;
+
+constexpr size_t COMPONENT_COUNT = ComponentList::size;
+
+// One bit per registered component
+typedef uint64_t ComponentMask;
+static_assert(COMPONENT_COUNT <= 64, "ComponentMask is 64 bits - widen it before registering more components");
+
+template<typename C, typename List>
+struct ComponentIndex;
+
+template<typename C, typename... Ts>
+struct ComponentIndex<C, ComponentTypeList<C, Ts...>> {
+    static constexpr size_t value = 0;
+};
+
+template<typename C, typename T, typename... Ts>
+struct ComponentIndex<C, ComponentTypeList<T, Ts...>> {
+    static constexpr size_t value = 1 + ComponentIndex<C, ComponentTypeList<Ts...>>::value;
+};
+
+template<typename C>
+struct ComponentIndex<C, ComponentTypeList<>> {
+    static_assert(!std::is_same_v<C, C>, "Component type is not registered in ComponentList (component_registry.hpp)");
+    static constexpr size_t value = 0;
+};
+
+template<typename C>
+constexpr size_t componentTypeId()
+{
+    return ComponentIndex<std::remove_cv_t<C>, ComponentList>::value;
+}
+
+template<typename... Cs>
+constexpr ComponentMask componentMask()
+{
+    return (ComponentMask(0) | ... | (ComponentMask(1) << componentTypeId<Cs>()));
+}
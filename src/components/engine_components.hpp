@@ -2,6 +2,7 @@
 
 #include "../vec2.hpp"
 #include "base_component.hpp"
+#include "../graphics/texture_atlas.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <cstdio>
@@ -9,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
 #include <algorithm>
 
 // Core Engine Components - These are engine-level systems
@@ -187,6 +189,9 @@ public:
 
   CSprite(const std::string &n, const sf::Texture &texture)
       : sprite{texture}, name{n} {};
+  // Draws from a sub-rectangle, e.g. an atlas page region
+  CSprite(const std::string &n, const TextureRegion &region)
+      : sprite{*region.texture, region.rect}, name{n} {};
   ~CSprite() {};
 };
 
@@ -198,6 +203,7 @@ public:
   float frameTime = 0.1f;    // time per frame in seconds
   float frameTimer = 0.0f;   // current time accumulator
   Vec2 frameSize = {32, 32}; // size of each frame in sprite sheet
+  sf::Vector2i sheetOrigin = {0, 0}; // top-left of the sheet on its texture (atlas region)
   bool repeat = true;
 
   // Animation definitions - maps animation name to row and flip settings
@@ -274,8 +280,8 @@ public:
 
     auto &animData = animations[currentAnimation];
 
-    int frameX = currentFrame * frameSize.x;
-    int frameY = animData.row * frameSize.y;
+    int frameX = sheetOrigin.x + currentFrame * frameSize.x;
+    int frameY = sheetOrigin.y + animData.row * frameSize.y;
 
     // Set texture rectangle with flipping support
     if (animData.flipX) {
@@ -337,15 +343,11 @@ class CSound : public Component {
 public:
   std::map<std::string, sf::Sound> sounds;
   std::map<std::string, sf::SoundBuffer> soundBuffers;
-  std::map<std::string, sf::Music *> music; // For background music (streaming)
+  std::map<std::string, std::unique_ptr<sf::Music>> music; // For background music (streaming)
 
+  // Movable but not copyable: sounds point at buffers owned by this component,
+  // and moving the maps keeps those nodes (and the pointers) intact
   CSound() {};
-  ~CSound() {
-    // Clean up music pointers
-    for (auto &pair : music) {
-      delete pair.second;
-    }
-  };
 
   // Add a sound effect (loaded into memory)
   bool addSound(const std::string &name, const std::string &filename) {
@@ -361,13 +363,12 @@ public:
 
   // Add background music (streamed from file)
   bool addMusic(const std::string &name, const std::string &filename) {
-    sf::Music *musicPtr = new sf::Music();
+    auto musicPtr = std::make_unique<sf::Music>();
     if (musicPtr->openFromFile(filename)) {
-      music[name] = musicPtr;
+      music[name] = std::move(musicPtr);
       return true;
     }
     std::printf("Failed to load music: %s\n", filename.c_str());
-    delete musicPtr;
     return false;
   }
 
@@ -618,3 +619,38 @@ public:
         return getWorldPosition();
     }
 };
+
+// Path following for grid movers - set a goal cell and Scene_PlayGrid requests a path
+// from its PathfindingService, then steps the entity's CGridMovement along it
+class CPath : public Component {
+public:
+    Vec2 goal;                     // Goal cell (grid coordinates, like CGridMovement::gridPos)
+    std::vector<Vec2> waypoints;   // Cells still to walk, in order
+    size_t nextWaypoint = 0;
+    uint32_t requestId = 0;        // Pending PathfindingService request, 0 when none
+    bool needsPath = false;        // Goal changed, a new request is due
+    bool unreachable = false;      // The last request found no path
+    
+    CPath() {}
+    
+    void setGoal(const Vec2& cell) {
+        goal = cell;
+        waypoints.clear();
+        nextWaypoint = 0;
+        needsPath = true;
+        unreachable = false;
+    }
+    
+    bool hasPath() const { return nextWaypoint < waypoints.size(); }
+};
+
+// Steers a grid mover along one of Scene_PlayGrid's shared flow fields (field 0 leads to
+// the player) - many agents share one field instead of each searching its own path.
+// Use either this or CPath on an entity, not both.
+class CFlowAgent : public Component {
+public:
+    uint32_t field = 0;    // Scene_PlayGrid flow field index
+    int stopDistance = 1;  // Stop this many steps short of the goal (1 = next to it)
+    
+    CFlowAgent(uint32_t fieldIndex = 0, int stop = 1) : field(fieldIndex), stopDistance(stop) {}
+};
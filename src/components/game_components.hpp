@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_component.hpp"
+#include "../entity.hpp"
 #include "vec2.hpp"
 #include <map>
 #include <vector>
@@ -14,7 +15,6 @@
 class Skill;
 class Item;
 class Equipment;
-class Entity;
 
 // Game-Specific Components - RPG Business Logic
 
@@ -425,14 +425,14 @@ private:
 // Battle Action Structure
 struct BattleAction {
     ActionType type = ActionType::ATTACK;
-    std::shared_ptr<Entity> actor;
-    std::shared_ptr<Entity> target;
-    std::vector<std::shared_ptr<Entity>> targets; // For multi-target skills
+    Entity actor;
+    Entity target;
+    std::vector<Entity> targets; // For multi-target skills
     std::shared_ptr<Skill> skill;
     std::shared_ptr<Item> item;
     
     BattleAction() = default;
-    BattleAction(ActionType t, std::shared_ptr<Entity> a, std::shared_ptr<Entity> tgt) 
+    BattleAction(ActionType t, Entity a, Entity tgt) 
         : type(t), actor(a), target(tgt) {}
 };
 
@@ -442,12 +442,12 @@ public:
     // Battle State
     BattleState currentState = BattleState::BATTLE_START;
     int currentTurn = 0;
-    std::queue<std::shared_ptr<Entity>> turnOrder;
-    std::shared_ptr<Entity> currentActor;
+    std::queue<Entity> turnOrder;
+    Entity currentActor;
     
     // Participants
-    std::vector<std::shared_ptr<Entity>> playerParty;
-    std::vector<std::shared_ptr<Entity>> enemyParty;
+    std::vector<Entity> playerParty;
+    std::vector<Entity> enemyParty;
     
     // Battle Results
     int experienceGained = 0;
@@ -461,7 +461,7 @@ public:
     CBattleSystem() = default;
     
     // Battle flow methods
-    void initializeBattle(const std::vector<std::shared_ptr<Entity>>& enemies);
+    void initializeBattle(const std::vector<Entity>& enemies);
     void calculateTurnOrder();
     void processAction(const BattleAction& action);
     bool checkBattleEnd();
@@ -469,8 +469,8 @@ public:
     void advanceTurn();
     
     // Utility methods
-    std::vector<std::shared_ptr<Entity>> getAlivePartyMembers(bool playerParty) const;
-    std::shared_ptr<Entity> getNextActor();
+    std::vector<Entity> getAlivePartyMembers(bool playerParty) const;
+    Entity getNextActor();
     void addToBattleLog(const std::string& message);
 };
 
@@ -754,20 +754,20 @@ public:
         : id(skillId), name(skillName), element(elem), basePower(power) {}
     
     // Skill execution
-    virtual void execute(std::shared_ptr<Entity> caster, 
-                        const std::vector<std::shared_ptr<Entity>>& targets) const;
+    virtual void execute(Entity caster, 
+                        const std::vector<Entity>& targets) const;
     
     // Validation
-    bool canUse(std::shared_ptr<Entity> caster) const;
-    bool isValidTarget(std::shared_ptr<Entity> target, std::shared_ptr<Entity> caster) const;
+    bool canUse(Entity caster) const;
+    bool isValidTarget(Entity target, Entity caster) const;
     
     // Utility
     std::string getElementName() const;
     std::string getTargetingDescription() const;
     
 protected:
-    virtual int calculateDamage(std::shared_ptr<Entity> caster, std::shared_ptr<Entity> target) const;
-    virtual bool rollHit(std::shared_ptr<Entity> caster, std::shared_ptr<Entity> target) const;
+    virtual int calculateDamage(Entity caster, Entity target) const;
+    virtual bool rollHit(Entity caster, Entity target) const;
     virtual bool rollCritical() const;
 };
 
@@ -780,8 +780,8 @@ public:
         targetsAllies = false;
     }
     
-    void execute(std::shared_ptr<Entity> caster, 
-                const std::vector<std::shared_ptr<Entity>>& targets) const override;
+    void execute(Entity caster, 
+                const std::vector<Entity>& targets) const override;
 };
 
 class HealingSkill : public Skill {
@@ -794,8 +794,8 @@ public:
         cannotMiss = true;
     }
     
-    void execute(std::shared_ptr<Entity> caster, 
-                const std::vector<std::shared_ptr<Entity>>& targets) const override;
+    void execute(Entity caster, 
+                const std::vector<Entity>& targets) const override;
 };
 
 class BuffSkill : public Skill {
@@ -849,8 +849,8 @@ public:
     virtual ~Item() = default;
     
     // Item usage
-    virtual bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) = 0;
-    virtual bool canUse(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) const;
+    virtual bool use(Entity user, Entity target) = 0;
+    virtual bool canUse(Entity user, Entity target) const;
     
     // Utility
     virtual std::string getUseDescription() const { return "Use " + name; }
@@ -869,7 +869,7 @@ public:
         targetsAllies = true;
     }
     
-    bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) override;
+    bool use(Entity user, Entity target) override;
     Item* clone() const override { return new HealingItem(*this); }
     std::string getUseDescription() const override;
 };
@@ -885,7 +885,7 @@ public:
         targetsAllies = true;
     }
     
-    bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) override;
+    bool use(Entity user, Entity target) override;
     Item* clone() const override { return new MPRestorationItem(*this); }
 };
 
@@ -900,7 +900,7 @@ public:
         targetsAllies = true;
     }
     
-    bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) override;
+    bool use(Entity user, Entity target) override;
     Item* clone() const override { return new StatusCureItem(*this); }
     void addCuredEffect(StatusEffectType effect) { curesStatusEffects.push_back(effect); }
 };
@@ -916,8 +916,8 @@ public:
         usableInField = false;  // Usually battle-only
     }
     
-    bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) override;
-    bool canUse(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) const override;
+    bool use(Entity user, Entity target) override;
+    bool canUse(Entity user, Entity target) const override;
     Item* clone() const override { return new ReviveItem(*this); }
 };
 
@@ -960,8 +960,8 @@ public:
         usableInField = false;
     }
     
-    bool use(std::shared_ptr<Entity> user, std::shared_ptr<Entity> target) override;
-    bool canEquip(std::shared_ptr<Entity> character) const;
+    bool use(Entity user, Entity target) override;
+    bool canEquip(Entity character) const;
     Item* clone() const override { return new Equipment(*this); }
     
     // Equipment-specific methods
@@ -13,14 +13,14 @@ void Character::createEntity(const std::string& entityType) {
 }
 
 Vec2 Character::getPosition() const {
-    if (m_entity && m_entity->hasComponent<CTransform>()) {
-        return m_entity->getComponent<CTransform>()->pos;
+    if (m_entity && m_entity.hasComponent<CTransform>()) {
+        return m_entity.getComponent<CTransform>()->pos;
     }
     return Vec2{0, 0};
 }
 
 void Character::setPosition(const Vec2& position) {
-    if (m_entity && m_entity->hasComponent<CTransform>()) {
-        m_entity->getComponent<CTransform>()->pos = position;
+    if (m_entity && m_entity.hasComponent<CTransform>()) {
+        m_entity.getComponent<CTransform>()->pos = position;
     }
 }
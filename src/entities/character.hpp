@@ -1,5 +1,5 @@
 #pragma once
-#include "../entity.hpp"
+#include "../entity_manager.hpp"
 #include "../components/engine_components.hpp"
 #include "../vec2.hpp"
 #include <memory>
@@ -11,7 +11,7 @@ class EntityManager;
 // Base class for all characters (Player, NPCs, etc.)
 class Character {
 protected:
-    std::shared_ptr<Entity> m_entity;
+    Entity m_entity;
     GameEngine* m_game;
     EntityManager* m_entityManager;
     std::string m_name;
@@ -29,7 +29,7 @@ public:
     void createEntity(const std::string& entityType);
     
     // Getters
-    std::shared_ptr<Entity> getEntity() const { return m_entity; }
+    Entity getEntity() const { return m_entity; }
     const std::string& getName() const { return m_name; }
     Vec2 getPosition() const;
     
@@ -39,18 +39,16 @@ public:
     // Component helpers
     template<typename T>
     bool hasComponent() const {
-        return m_entity && m_entity->hasComponent<T>();
+        return m_entity && m_entity.hasComponent<T>();
     }
     
     template<typename T>
-    std::shared_ptr<T> getComponent() const {
-        return m_entity ? m_entity->getComponent<T>() : nullptr;
+    T* getComponent() const {
+        return m_entity ? m_entity.getComponent<T>() : nullptr;
     }
     
-    template<typename T>
-    void addComponent(std::shared_ptr<T> component) {
-        if (m_entity) {
-            m_entity->addComponent<T>(component);
-        }
+    template<typename T, typename... Args>
+    T* addComponent(Args&&... args) {
+        return m_entity ? m_entity.addComponent<T>(std::forward<Args>(args)...) : nullptr;
     }
 };
@@ -22,12 +22,12 @@ void NPC::init(const Vec2& position) {
 }
 
 void NPC::setupComponents(const Vec2& position) {
-    addComponent<CTransform>(std::make_shared<CTransform>(position));
+    addComponent<CTransform>(position);
     
     auto& npcTexture = m_game->getAssets().getTexture(m_textureName);
-    addComponent<CSprite>(std::make_shared<CSprite>(m_textureName, npcTexture));
+    addComponent<CSprite>(m_textureName, npcTexture);
    
-    addComponent<CBoundingBox>(std::make_shared<CBoundingBox>(m_tileSize));
+    addComponent<CBoundingBox>(m_tileSize);
 }
 
 void NPC::update(float deltaTime) {
@@ -23,11 +23,11 @@ void Player::init(const Vec2& position) {
 
 void Player::setupComponents(const Vec2& position) {
     // Add transform component
-    addComponent<CTransform>(std::make_shared<CTransform>(position));
+    addComponent<CTransform>(position);
     
     // Add sprite component with player texture
     auto& playerTexture = m_game->getAssets().getTexture("Player");
-    addComponent<CSprite>(std::make_shared<CSprite>("Player", playerTexture));
+    addComponent<CSprite>("Player", playerTexture);
     
     // Set up sprite sheet frame (32x32 pixel frames based on the sprite sheet)
     auto sprite = getComponent<CSprite>();
@@ -36,20 +36,19 @@ void Player::setupComponents(const Vec2& position) {
     }
     
     // Add grid movement component
-    auto gridMovement = std::make_shared<CGridMovement>(m_gameScale, 3.0f, true); // Scale-based grid, 3 moves/sec, smooth
+    auto gridMovement = addComponent<CGridMovement>(m_gameScale, 3.0f, true); // Scale-based grid, 3 moves/sec, smooth
     gridMovement->snapToGrid(position); // Snap player to nearest grid position
-    addComponent<CGridMovement>(gridMovement);
     
     // Add bounding box
-    addComponent<CBoundingBox>(std::make_shared<CBoundingBox>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)}));
+    addComponent<CBoundingBox>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
     
     // Add input component
-    addComponent<CInput>(std::make_shared<CInput>());
+    addComponent<CInput>();
 }
 
 void Player::setupAnimations() {
     // Add animation component with flexible animation definitions
-    auto animationComponent = std::make_shared<CAnimation>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)});
+    auto animationComponent = addComponent<CAnimation>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)});
 
     // Define animations - using the same texture with different rows
     animationComponent->addAnimation("idle", "Player", 6, 0.2f, false, 0);        // Row 0, 6 frames, slow
@@ -59,18 +58,16 @@ void Player::setupAnimations() {
     animationComponent->addAnimation("walk_left", "Player", 6, 0.15f, true, 1);   // Row 1, flipped
 
     animationComponent->play("idle"); // Start with idle animation
-    addComponent<CAnimation>(animationComponent);
 }
 
 void Player::setupCamera(const Vec2& position) {
     // Add camera component with 1-tile dead zone
     Vec2 deadZoneSize = {static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)}; // 1 tile dead zone
-    auto cameraComponent = std::make_shared<CCamera>(position, deadZoneSize, 3.0f); // Follow speed of 3.0
+    auto cameraComponent = addComponent<CCamera>(position, deadZoneSize, 3.0f); // Follow speed of 3.0
     
     // Ensure camera starts exactly at player position (centered)
     cameraComponent->setPosition(position);  // This sets both position and targetPosition
     
-    addComponent<CCamera>(cameraComponent);
     
     // Initialize game view to center player in middle of screen
     sf::View& gameView = m_game->getGameView();
@@ -81,12 +78,11 @@ void Player::setupCamera(const Vec2& position) {
 
 void Player::setupSound() {
     // Add sound component
-    auto soundComponent = std::make_shared<CSound>();
+    auto soundComponent = addComponent<CSound>();
     // Load player-specific sounds
     soundComponent->addSound("footstep", "assets/sounds/tap.wav");
     soundComponent->addSound("hurt", "assets/sounds/hurt.wav");
     soundComponent->addSound("jump", "assets/sounds/jump.wav");
-    addComponent<CSound>(soundComponent);
 }
 
 void Player::update(float deltaTime) {
@@ -1,38 +1,54 @@
-#include "entity.hpp"
+#include "entity_manager.hpp"
 
-Entity::Entity()
+Entity::Entity(EntityManager *manager, uint32_t index, uint32_t generation)
+    : m_manager(manager), m_index(index), m_generation(generation)
 {
-
 }
 
-Entity::Entity(const std::string &tag, size_t id)
-    : m_id(id), m_tag(tag)
+const std::string &Entity::tag() const
 {
+    static const std::string invalidTag = "";
+    return isValid() ? TagRegistry::name(m_manager->getSlot(m_index).tag) : invalidTag;
 }
 
-Entity::~Entity()
+TagId Entity::tagId() const
 {
-
+    return isValid() ? m_manager->getSlot(m_index).tag : INVALID_TAG;
 }
 
-const std::string &Entity::tag() const
+size_t Entity::id() const
 {
-    return m_tag;
+    return m_index;
 }
 
-size_t Entity::id() const
+uint32_t Entity::generation() const
 {
-    return m_id;
+    return m_generation;
 }
 
 void Entity::destroy()
 {
-    m_active = false;
+    if (isValid())
+    {
+        m_manager->destroyEntity(m_index);
+    }
 }
+
 bool Entity::isActive() const
 {
-    return m_active;
+    return isValid() && m_manager->getSlot(m_index).active;
 }
+
+bool Entity::isValid() const
+{
+    return m_manager && m_manager->isValid(m_index, m_generation);
+}
+
+bool Entity::operator==(const Entity &other) const
+{
+    return m_manager == other.m_manager && m_index == other.m_index && m_generation == other.m_generation;
+}
+
 void Entity::print() const
 {
-}
\ No newline at end of file
+}
@@ -1,44 +1,58 @@
 #pragma once
-#include <memory>
-#include <map>
-#include <typeindex>
+#include <cstdint>
 #include <string>
 #include "components/base_component.hpp"
+#include "entity_tags.hpp"
 
+class EntityManager;
 
+// Lightweight generational handle to an entity slot in an EntityManager
+// - m_index picks the slot, m_generation must match the slot's current generation
+// - Once the entity is removed its slot generation is bumped, so stale handles
+//   are detected in O(1) and simply report no components
+// Handles are cheap to copy and compare; pass them by value
 class Entity {
 private:
-    size_t m_id;
-    const std::string m_tag = "Default";
-    bool m_active = true;
-
-    // Map to store components of various types
-    std::map<std::type_index, std::shared_ptr<Component>> m_components;
+    EntityManager* m_manager = nullptr;
+    uint32_t m_index = 0;
+    uint32_t m_generation = 0;
 
 public:
-    Entity();
-    Entity(const std::string& tag, size_t id);
-
-    ~Entity();
+    Entity() = default;
+    Entity(EntityManager* manager, uint32_t index, uint32_t generation);
 
     const std::string& tag() const;
+    TagId tagId() const;
     size_t id() const;
+    uint32_t generation() const;
     void destroy();
     bool isActive() const;
+    bool isValid() const;
     void print() const;
+
+    // A handle is "true" while it still refers to a live entity
+    explicit operator bool() const { return isValid(); }
+    bool operator==(const Entity& other) const;
+    bool operator!=(const Entity& other) const { return !(*this == other); }
     
     // Methods to add, retrieve, check, and remove components
+    // (definitions are in entity.tpp, included by entity_manager.hpp)
+    template<typename C, typename... Args>
+    C* addComponent(Args&&... args);
+
+    // getComponent marks the component as changed, readComponent doesn't
     template<typename C>
-    void addComponent(std::shared_ptr<C> component);
+    C* getComponent() const;
 
     template<typename C>
-    std::shared_ptr<C> getComponent() const;
+    const C* readComponent() const;
 
     template<typename C>
     bool hasComponent() const;
 
+    template<typename... Cs>
+    bool hasComponents() const;
+
     template<typename C>
     void removeComponent();
 };
-
-#include "entity.tpp"
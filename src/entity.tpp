@@ -1,25 +1,36 @@
-#include "entity.hpp"
+#include "entity_manager.hpp"
+
+template<typename C, typename... Args>
+C* Entity::addComponent(Args&&... args) {
+    if (!isValid()) {
+        return nullptr;
+    }
+    return &m_manager->addComponent<C>(m_index, std::forward<Args>(args)...);
+}
 
 template<typename C>
-void Entity::addComponent(std::shared_ptr<C> component) {
-    m_components[typeid(C)] = std::static_pointer_cast<Component>(component);
+C* Entity::getComponent() const {
+    return isValid() ? m_manager->getComponent<C>(m_index) : nullptr;
 }
 
 template<typename C>
-std::shared_ptr<C> Entity::getComponent() const {
-    auto it = m_components.find(typeid(C));
-    if (it != m_components.end()) {
-        return std::static_pointer_cast<C>(it->second);
-    }
-    return nullptr;
+const C* Entity::readComponent() const {
+    return isValid() ? m_manager->readComponent<C>(m_index) : nullptr;
 }
 
 template<typename C>
 bool Entity::hasComponent() const {
-    return m_components.find(typeid(C)) != m_components.end();
+    return isValid() && m_manager->hasComponent<C>(m_index);
+}
+
+template<typename... Cs>
+bool Entity::hasComponents() const {
+    return isValid() && m_manager->hasComponents<Cs...>(m_index);
 }
 
 template<typename C>
 void Entity::removeComponent() {
-    m_components.erase(typeid(C));
-}
\ No newline at end of file
+    if (isValid()) {
+        m_manager->removeComponent<C>(m_index);
+    }
+}
@@ -0,0 +1,17 @@
+#include "entity_manager.hpp"
+
+Entity EntityCommandBuffer::spawnEntity(EntityManager &manager, TagId tag)
+{
+    return manager.addEntity(tag);
+}
+
+void EntityCommandBuffer::playback(EntityManager &manager)
+{
+    m_spawned.clear();
+    for (auto &command : m_commands)
+    {
+        command(manager, m_spawned);
+    }
+    m_commands.clear();
+    m_spawnCount = 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "entity.hpp"
+#include "entity_tags.hpp"
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class EntityManager;
+
+// Records structural changes (spawn, destroy, add/remove component) for later playback
+// EntityManager::update() replays every buffer in the order the buffers were created,
+// so the result doesn't depend on which worker thread finished first.
+// A buffer is not synchronised - give each system (or each thread) its own, created
+// through EntityManager::createCommandBuffer() during setup.
+class EntityCommandBuffer {
+public:
+    // Placeholder for an entity spawned through this buffer, resolved at playback
+    struct Spawned {
+        uint32_t index;
+    };
+
+    Spawned spawn(TagId tag)
+    {
+        m_commands.push_back([tag](EntityManager& manager, std::vector<Entity>& spawned) {
+            spawned.push_back(spawnEntity(manager, tag));
+        });
+        return Spawned{m_spawnCount++};
+    }
+
+    void destroy(Entity entity)
+    {
+        m_commands.push_back([entity](EntityManager&, std::vector<Entity>&) mutable {
+            entity.destroy();
+        });
+    }
+
+    // Arguments are copied into the buffer and forwarded to C's constructor at playback
+    template<typename C, typename... Args>
+    void addComponent(Entity entity, Args&&... args)
+    {
+        m_commands.push_back([entity, ...args = std::forward<Args>(args)](EntityManager&, std::vector<Entity>&) mutable {
+            entity.addComponent<C>(std::move(args)...);
+        });
+    }
+
+    template<typename C, typename... Args>
+    void addComponent(Spawned entity, Args&&... args)
+    {
+        m_commands.push_back([entity, ...args = std::forward<Args>(args)](EntityManager&, std::vector<Entity>& spawned) mutable {
+            spawned[entity.index].addComponent<C>(std::move(args)...);
+        });
+    }
+
+    template<typename C>
+    void removeComponent(Entity entity)
+    {
+        m_commands.push_back([entity](EntityManager&, std::vector<Entity>&) mutable {
+            entity.removeComponent<C>();
+        });
+    }
+
+    bool empty() const { return m_commands.empty(); }
+
+private:
+    friend class EntityManager;
+
+    // Applies every recorded command in order and clears the buffer
+    void playback(EntityManager& manager);
+    static Entity spawnEntity(EntityManager& manager, TagId tag);
+
+    std::vector<std::function<void(EntityManager&, std::vector<Entity>&)>> m_commands;
+    std::vector<Entity> m_spawned; // Scratch list mapping Spawned::index -> real handle during playback
+    uint32_t m_spawnCount = 0;
+};
@@ -1,44 +1,206 @@
 #include "entity_manager.hpp"
 
+void EntityManager::removeAllComponents(size_t entityId)
+{
+    // Only visit the pools named in the entity's mask
+    ComponentMask &mask = m_slots[entityId].mask;
+    for (size_t typeId = 0; mask != 0; typeId++, mask >>= 1)
+    {
+        if (mask & 1)
+        {
+            m_pools[typeId]->remove(entityId);
+        }
+    }
 
-void EntityManager::removeDeadEntities()
+    for (auto &query : m_queries)
+    {
+        if (query)
+        {
+            query->erase(static_cast<uint32_t>(entityId));
+        }
+    }
+}
+
+EntityQuery &EntityManager::createQuery(size_t queryId, const std::vector<size_t> &types, ComponentMask mask)
 {
-    // Remove dead entities from main vector
-    m_entities.erase(std::remove_if(m_entities.begin(), m_entities.end(), 
-        [](auto &e) { return !e->isActive(); }), m_entities.end());
+    m_queries[queryId] = std::make_unique<EntityQuery>(types, mask);
+    EntityQuery &query = *m_queries[queryId];
 
-    // Remove dead entities from each tag map
-    for (auto &pair : m_entityMap)
+    for (size_t typeId : types)
+    {
+        m_queriesByComponent[typeId].push_back(&query);
+    }
+
+    // Initial fill: scan the smallest pool and keep the entities that have everything else
+    const ComponentPoolBase *smallest = nullptr;
+    for (size_t typeId : types)
+    {
+        if (!smallest || m_pools[typeId]->size() < smallest->size())
+        {
+            smallest = m_pools[typeId].get();
+        }
+    }
+    if (smallest)
+    {
+        for (size_t entityId : smallest->entities())
+        {
+            if (hasComponentMask(entityId, mask))
+            {
+                query.insert(static_cast<uint32_t>(entityId));
+            }
+        }
+    }
+
+    return query;
+}
+
+void EntityManager::onComponentAdded(size_t typeId, size_t entityId)
+{
+    for (EntityQuery *query : m_queriesByComponent[typeId])
+    {
+        if (hasComponentMask(entityId, query->mask()))
+        {
+            query->insert(static_cast<uint32_t>(entityId));
+        }
+    }
+}
+
+void EntityManager::onComponentRemoved(size_t typeId, size_t entityId)
+{
+    for (EntityQuery *query : m_queriesByComponent[typeId])
+    {
+        query->erase(static_cast<uint32_t>(entityId));
+    }
+}
+
+void EntityManager::removeDeadEntities()
+{
+    // Only the entities destroyed this frame are visited - a frame without deaths does no work
+    for (uint32_t index : m_dead)
     {
-        pair.second.erase(std::remove_if(pair.second.begin(), pair.second.end(), 
-            [](auto &e) { return !e->isActive(); }), pair.second.end());
+        EntitySlot &slot = m_slots[index];
+
+        // Swap-and-pop out of the main vector and the tag bucket using the back-indices
+        // (entities destroyed before they were ever added have no list entries yet)
+        if (slot.listed)
+        {
+            uint32_t moved = m_entities.back();
+            m_entities[slot.entityIndex] = moved;
+            m_slots[moved].entityIndex = slot.entityIndex;
+            m_entities.pop_back();
+
+            EntityVec &bucket = m_entityMap[slot.tag];
+            moved = bucket.back();
+            bucket[slot.tagIndex] = moved;
+            m_slots[moved].tagIndex = slot.tagIndex;
+            bucket.pop_back();
+
+            slot.listed = false;
+        }
+
+        // Release the slot: drop its components and bump the generation so old handles go stale
+        removeAllComponents(index);
+        slot.generation++;
+        m_freeSlots.push_back(index);
     }
+    m_dead.clear();
 }
 
 void EntityManager::update()
 {
+    // Sync point: apply what systems recorded last frame before anything else
+    for (auto &buffer : m_commandBuffers)
+    {
+        buffer->playback(*this);
+    }
+
     removeDeadEntities();
-    for (auto e : m_toAdd)
+
+    // Keep a bounded window of change history; readers further behind fall back to a scan
+    if (m_changeTick > CHANGE_LOG_HISTORY)
     {
-        m_entities.push_back(e);
-        m_entityMap[e->tag()].push_back(e);
+        for (auto &pool : m_pools)
+        {
+            if (pool)
+            {
+                pool->trimChangeLog(m_changeTick - CHANGE_LOG_HISTORY);
+            }
+        }
+    }
+
+    for (uint32_t index : m_toAdd)
+    {
+        // Skip entities that were destroyed (and already freed) before being added
+        EntitySlot &slot = m_slots[index];
+        if (!slot.active)
+        {
+            continue;
+        }
+
+        if (slot.tag >= m_entityMap.size())
+        {
+            m_entityMap.resize(slot.tag + 1);
+        }
+        EntityVec &bucket = m_entityMap[slot.tag];
+        slot.entityIndex = static_cast<uint32_t>(m_entities.size());
+        slot.tagIndex = static_cast<uint32_t>(bucket.size());
+        slot.listed = true;
+        m_entities.push_back(index);
+        bucket.push_back(index);
     }
     m_toAdd.clear();
 }
 
-std::shared_ptr<Entity> EntityManager::addEntity(const std::string &tag)
+void EntityManager::destroyEntity(uint32_t index)
 {
-    auto e = std::shared_ptr<Entity>(new Entity(tag, m_totalEntities++));
-    m_toAdd.push_back(e);
-    return e;
+    EntitySlot &slot = m_slots[index];
+    if (slot.active)
+    {
+        slot.active = false;
+        m_dead.push_back(index);
+    }
 }
 
-EntityVec &EntityManager::getEntities()
+Entity EntityManager::addEntity(TagId tag)
 {
-    return m_entities;
+    uint32_t index;
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    EntitySlot &slot = m_slots[index];
+    slot.active = true;
+    slot.tag = tag;
+
+    m_toAdd.push_back(index);
+    return Entity(this, index, slot.generation);
+}
+
+EntityCommandBuffer &EntityManager::createCommandBuffer()
+{
+    m_commandBuffers.push_back(std::make_unique<EntityCommandBuffer>());
+    return *m_commandBuffers.back();
 }
 
-EntityVec &EntityManager::getEntities(const std::string &tag)
+EntityList EntityManager::getEntities()
 {
-    return m_entityMap[tag];
+    return EntityList(this, m_entities);
+}
+
+EntityList EntityManager::getEntities(TagId tag)
+{
+    // Tags nobody has spawned yet have no bucket - hand back a shared empty list
+    static const EntityVec empty;
+    if (tag >= m_entityMap.size())
+    {
+        return EntityList(this, empty);
+    }
+    return EntityList(this, m_entityMap[tag]);
 }
@@ -1,25 +1,334 @@
 #pragma once
 #include "entity.hpp"
+#include "component_pool.hpp"
+#include "entity_query.hpp"
+#include "entity_command_buffer.hpp"
+#include "entity_tags.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
 #include <vector>
-#include <map>
 
-typedef std::vector<std::shared_ptr<Entity>> EntityVec;
-typedef std::map<std::string, EntityVec> EntityMap;
+// Entity lists hold plain slot indices; handles are rebuilt from the slot table on access
+typedef std::vector<uint32_t> EntityVec;
+typedef std::vector<EntityVec> EntityMap; // Tag buckets, indexed by TagId
+
+// One entry in the entity slot table
+// The generation is bumped every time the slot is freed, invalidating old handles
+// mask has one bit per component the entity owns (see component_registry.hpp)
+// entityIndex / tagIndex are back-indices into m_entities and the tag bucket so
+// removal can swap-and-pop without searching
+struct EntitySlot {
+    uint32_t generation = 0;
+    bool active = false;
+    TagId tag = 0;
+    ComponentMask mask = 0;
+    uint32_t entityIndex = 0;
+    uint32_t tagIndex = 0;
+    bool listed = false; // Set once the entity is in m_entities and its tag bucket (after update())
+};
+
+// Iterable view over an EntityVec that yields Entity handles by value
+class EntityList {
+    EntityManager* m_manager;
+    const EntityVec* m_indices;
+
+public:
+    class iterator {
+        EntityManager* m_manager;
+        EntityVec::const_iterator m_it;
+
+    public:
+        iterator(EntityManager* manager, EntityVec::const_iterator it) : m_manager(manager), m_it(it) {}
+
+        Entity operator*() const;
+        iterator& operator++() { ++m_it; return *this; }
+        bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+        bool operator==(const iterator& other) const { return m_it == other.m_it; }
+    };
+
+    EntityList(EntityManager* manager, const EntityVec& indices) : m_manager(manager), m_indices(&indices) {}
+
+    iterator begin() const { return iterator(m_manager, m_indices->begin()); }
+    iterator end() const { return iterator(m_manager, m_indices->end()); }
+    size_t size() const { return m_indices->size(); }
+    bool empty() const { return m_indices->empty(); }
+    Entity operator[](size_t i) const;
+};
+
+template<typename... Cs>
+class EntityView;
 
 class EntityManager
 {
     EntityVec m_entities;
     EntityVec m_toAdd;
     EntityMap m_entityMap;
-    size_t m_totalEntities = 0;
+
+    // Slot table - freed slots are recycled through m_freeSlots instead of allocating new entities
+    std::vector<EntitySlot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+
+    // Entities destroyed since the last update(), so removal touches only them
+    EntityVec m_dead;
+
+    // Change tick stamped onto modified components (see changeTick())
+    static constexpr uint32_t CHANGE_LOG_HISTORY = 64;
+    uint32_t m_changeTick = 1;
+
+    // Deferred structural changes from systems, replayed in creation order by update()
+    std::vector<std::unique_ptr<EntityCommandBuffer>> m_commandBuffers;
+
+    // One sparse-set pool per component type, indexed by componentTypeId<C>()
+    std::array<std::unique_ptr<ComponentPoolBase>, COMPONENT_COUNT> m_pools;
+
+    // Cached view queries, indexed by queryTypeId<Cs...>(), plus the queries
+    // that depend on each component type so add/remove only touches those
+    std::vector<std::unique_ptr<EntityQuery>> m_queries;
+    std::array<std::vector<EntityQuery*>, COMPONENT_COUNT> m_queriesByComponent;
+
+    void removeAllComponents(size_t entityId);
+    bool hasComponentMask(size_t entityId, ComponentMask mask) const
+    {
+        return (m_slots[entityId].mask & mask) == mask;
+    }
+    EntityQuery& createQuery(size_t queryId, const std::vector<size_t>& types, ComponentMask mask);
+    void onComponentAdded(size_t typeId, size_t entityId);
+    void onComponentRemoved(size_t typeId, size_t entityId);
 
 public:
     EntityManager(){};
     ~EntityManager(){};
 
     void update();
-    std::shared_ptr<Entity> addEntity(const std::string &tag);
-    EntityVec& getEntities();
-    EntityVec& getEntities(const std::string &tag);
+    Entity addEntity(TagId tag);
+    void destroyEntity(uint32_t index);
+    EntityList getEntities();
+    EntityList getEntities(TagId tag);
+
+    // String overloads intern the tag first - fine for loading and tooling,
+    // per-frame code should pass a precomputed TagId (see EntityTags)
+    Entity addEntity(const std::string &tag) { return addEntity(TagRegistry::intern(tag)); }
+    EntityList getEntities(const std::string &tag) { return getEntities(TagRegistry::intern(tag)); }
     void removeDeadEntities();
-};
\ No newline at end of file
+
+    // New command buffer for one system/thread to record spawns and component changes into
+    // Create buffers during setup (not while systems are running); the manager owns them
+    EntityCommandBuffer& createCommandBuffer();
+
+    // Slot table access (used by Entity handles)
+    Entity getEntity(uint32_t index) { return Entity(this, index, m_slots[index].generation); }
+    EntitySlot& getSlot(uint32_t index) { return m_slots[index]; }
+    bool isValid(uint32_t index, uint32_t generation) const
+    {
+        return index < m_slots.size() && m_slots[index].generation == generation;
+    }
+
+    // Packed storage for one component type - iterate it to walk every C in the scene
+    template<typename C>
+    ComponentPool<C>& getComponents();
+
+    template<typename C, typename... Args>
+    C& addComponent(size_t entityId, Args&&... args);
+
+    // Mutable access - marks the component as changed at the current change tick
+    template<typename C>
+    C* getComponent(size_t entityId);
+
+    // Read-only access - does not mark anything, use it in systems that only read
+    template<typename C>
+    const C* readComponent(size_t entityId) const;
+
+    template<typename C>
+    bool hasComponent(size_t entityId) const;
+
+    // True when the entity has every component in Cs - a single mask comparison
+    template<typename... Cs>
+    bool hasComponents(size_t entityId) const;
+
+    template<typename C>
+    void removeComponent(size_t entityId);
+
+    // Entities that have every component in Cs, with direct component references
+    //   for (auto [entity, transform, sprite] : m_entityManager.view<CTransform, CSprite>()) { ... }
+    // The match list is built on first use and maintained incrementally afterwards
+    // Non-const components are marked changed as they are visited; list a component as
+    // const (view<const CTransform, CSprite>) when the system only reads it
+    template<typename... Cs>
+    EntityView<Cs...> view();
+
+    // Change tracking: components modified after this call get a later tick than the one
+    // returned. A system stores it and passes it to EntityView::eachChanged() on its next run
+    // to visit only what changed in between. Call from the main thread, outside parallel systems.
+    uint32_t changeTick() { return m_changeTick++; }
+};
+
+inline Entity EntityList::iterator::operator*() const
+{
+    return m_manager->getEntity(*m_it);
+}
+
+inline Entity EntityList::operator[](size_t i) const
+{
+    return m_manager->getEntity((*m_indices)[i]);
+}
+
+template<typename C>
+ComponentPool<C>& EntityManager::getComponents()
+{
+    constexpr size_t typeId = componentTypeId<C>();
+    if (!m_pools[typeId]) {
+        m_pools[typeId] = std::make_unique<ComponentPool<C>>(&m_changeTick);
+    }
+    return static_cast<ComponentPool<C>&>(*m_pools[typeId]);
+}
+
+template<typename C, typename... Args>
+C& EntityManager::addComponent(size_t entityId, Args&&... args)
+{
+    auto& pool = getComponents<C>();
+    bool existed = pool.has(entityId);
+    C& component = pool.emplace(entityId, std::forward<Args>(args)...);
+    if (!existed) {
+        m_slots[entityId].mask |= componentMask<C>();
+        onComponentAdded(componentTypeId<C>(), entityId);
+    }
+    return component;
+}
+
+template<typename C>
+C* EntityManager::getComponent(size_t entityId)
+{
+    constexpr size_t typeId = componentTypeId<C>();
+    if (!hasComponent<C>(entityId)) {
+        return nullptr;
+    }
+    return static_cast<ComponentPool<C>&>(*m_pools[typeId]).modify(entityId);
+}
+
+template<typename C>
+const C* EntityManager::readComponent(size_t entityId) const
+{
+    constexpr size_t typeId = componentTypeId<C>();
+    if (!hasComponent<C>(entityId)) {
+        return nullptr;
+    }
+    return static_cast<const ComponentPool<C>&>(*m_pools[typeId]).get(entityId);
+}
+
+template<typename C>
+bool EntityManager::hasComponent(size_t entityId) const
+{
+    return (m_slots[entityId].mask & componentMask<C>()) != 0;
+}
+
+template<typename... Cs>
+bool EntityManager::hasComponents(size_t entityId) const
+{
+    return hasComponentMask(entityId, componentMask<Cs...>());
+}
+
+template<typename C>
+void EntityManager::removeComponent(size_t entityId)
+{
+    constexpr size_t typeId = componentTypeId<C>();
+    if (hasComponent<C>(entityId)) {
+        m_pools[typeId]->remove(entityId);
+        m_slots[entityId].mask &= ~componentMask<C>();
+        onComponentRemoved(typeId, entityId);
+    }
+}
+
+template<typename... Cs>
+EntityView<Cs...> EntityManager::view()
+{
+    // view<const C> and view<C> share one cached query
+    size_t queryId = queryTypeId<std::remove_const_t<Cs>...>();
+    if (queryId >= m_queries.size()) {
+        m_queries.resize(queryId + 1);
+    }
+    if (!m_queries[queryId]) {
+        // Make sure every pool exists before the initial scan
+        (getComponents<std::remove_const_t<Cs>>(), ...);
+        createQuery(queryId, {componentTypeId<Cs>()...}, componentMask<Cs...>());
+    }
+    return EntityView<Cs...>(this, *m_queries[queryId], &getComponents<std::remove_const_t<Cs>>()...);
+}
+
+// Result of EntityManager::view<Cs...>() - iterates cached matches as (Entity, Cs&...) tuples
+// Adding or removing any of the viewed components while iterating invalidates the view
+template<typename... Cs>
+class EntityView {
+    template<typename C>
+    using Pool = ComponentPool<std::remove_const_t<C>>;
+
+    EntityManager* m_manager;
+    const EntityQuery* m_query;
+    std::tuple<Pool<Cs>*...> m_pools;
+
+    // const components are read as-is, mutable ones are marked changed
+    template<typename C>
+    C& fetch(uint32_t id) const
+    {
+        if constexpr (std::is_const_v<C>) {
+            return *std::get<Pool<C>*>(m_pools)->get(id);
+        } else {
+            return *std::get<Pool<C>*>(m_pools)->modify(id);
+        }
+    }
+
+public:
+    typedef std::tuple<Entity, Cs&...> value_type;
+
+    class iterator {
+        const EntityView* m_view;
+        EntityVec::const_iterator m_it;
+
+    public:
+        iterator(const EntityView* view, EntityVec::const_iterator it) : m_view(view), m_it(it) {}
+
+        value_type operator*() const { return m_view->get(*m_it); }
+        iterator& operator++() { ++m_it; return *this; }
+        bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+        bool operator==(const iterator& other) const { return m_it == other.m_it; }
+    };
+
+    EntityView(EntityManager* manager, const EntityQuery& query, Pool<Cs>*... pools)
+        : m_manager(manager), m_query(&query), m_pools(pools...) {}
+
+    iterator begin() const { return iterator(this, m_query->matches().begin()); }
+    iterator end() const { return iterator(this, m_query->matches().end()); }
+    size_t size() const { return m_query->matches().size(); }
+    bool empty() const { return m_query->matches().empty(); }
+
+    value_type get(uint32_t id) const
+    {
+        return value_type(m_manager->getEntity(id), fetch<Cs>(id)...);
+    }
+
+    // Calls fn(Entity, Cs&...) for every match
+    template<typename Fn>
+    void each(Fn&& fn) const
+    {
+        for (uint32_t id : m_query->matches()) {
+            fn(m_manager->getEntity(id), fetch<Cs>(id)...);
+        }
+    }
+
+    // Calls fn(Entity, Cs&...) for every match whose Changed component was modified after
+    // tick `since` (see EntityManager::changeTick()) - cost scales with the number of changes
+    template<typename Changed, typename Fn>
+    void eachChanged(uint32_t since, Fn&& fn) const
+    {
+        std::get<Pool<Changed>*>(m_pools)->eachChangedSince(since, [&](size_t entityId) {
+            uint32_t id = static_cast<uint32_t>(entityId);
+            if (m_query->contains(id)) {
+                fn(m_manager->getEntity(id), fetch<Cs>(id)...);
+            }
+        });
+    }
+};
+
+#include "entity.tpp"
@@ -0,0 +1,69 @@
+#pragma once
+#include "components/component_registry.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Runtime query IDs - every distinct view<Cs...>() instantiation gets its own cached query slot
+inline size_t nextQueryTypeId()
+{
+    static size_t next = 0;
+    return next++;
+}
+
+template<typename... Cs>
+size_t queryTypeId()
+{
+    static const size_t id = nextQueryTypeId();
+    return id;
+}
+
+// Cached match list for one component combination
+// EntityManager keeps it up to date as components are added and removed,
+// so systems iterate only the entities that match instead of filtering the whole world
+class EntityQuery {
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> m_types;     // componentTypeId of every required component
+    ComponentMask m_mask;            // the same set as a bitmask, for one-compare match tests
+    std::vector<uint32_t> m_matches; // packed slot indices of matching entities
+    std::vector<size_t> m_sparse;    // slot index -> position in m_matches (npos when absent)
+
+public:
+    EntityQuery(const std::vector<size_t>& types, ComponentMask mask) : m_types(types), m_mask(mask) {}
+
+    const std::vector<size_t>& types() const { return m_types; }
+    ComponentMask mask() const { return m_mask; }
+    const std::vector<uint32_t>& matches() const { return m_matches; }
+
+    bool contains(uint32_t id) const
+    {
+        return id < m_sparse.size() && m_sparse[id] != npos;
+    }
+
+    void insert(uint32_t id)
+    {
+        if (contains(id)) {
+            return;
+        }
+        if (id >= m_sparse.size()) {
+            m_sparse.resize(id + 1, npos);
+        }
+        m_sparse[id] = m_matches.size();
+        m_matches.push_back(id);
+    }
+
+    // Swap-and-pop - match order is not stable
+    void erase(uint32_t id)
+    {
+        if (!contains(id)) {
+            return;
+        }
+        size_t index = m_sparse[id];
+        uint32_t last = m_matches.back();
+        m_matches[index] = last;
+        m_sparse[last] = index;
+        m_matches.pop_back();
+        m_sparse[id] = npos;
+    }
+};
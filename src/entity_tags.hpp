@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+// Entity tags are interned into small dense IDs so EntityManager can keep its
+// tag buckets in a flat array and hot systems never hash or compare strings
+typedef uint32_t TagId;
+constexpr TagId INVALID_TAG = 0xFFFFFFFFu; // Reported by stale handles
+
+class TagRegistry {
+    std::unordered_map<std::string, TagId> m_ids;
+    std::deque<std::string> m_names; // deque keeps name() references stable as tags are added
+
+    static TagRegistry& instance()
+    {
+        static TagRegistry registry;
+        return registry;
+    }
+
+public:
+    // Returns the ID for a tag, registering it on first use
+    static TagId intern(const std::string& name)
+    {
+        TagRegistry& registry = instance();
+        auto it = registry.m_ids.find(name);
+        if (it != registry.m_ids.end()) {
+            return it->second;
+        }
+        TagId id = static_cast<TagId>(registry.m_names.size());
+        registry.m_names.push_back(name);
+        registry.m_ids.emplace(name, id);
+        return id;
+    }
+
+    static const std::string& name(TagId id) { return instance().m_names[id]; }
+    static size_t count() { return instance().m_names.size(); }
+};
+
+// Precomputed IDs for the tags the engine itself uses - compare against these
+// instead of string literals in per-frame code
+namespace EntityTags {
+    inline const TagId Player = TagRegistry::intern("Player");
+    inline const TagId NPC = TagRegistry::intern("NPC");
+    inline const TagId Tile = TagRegistry::intern("Tile");
+    inline const TagId LayeredTile = TagRegistry::intern("LayeredTile");
+}
@@ -0,0 +1,80 @@
+#include "debug_draw.hpp"
+#include <algorithm>
+#include <cmath>
+
+void DebugDraw::quad(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Vector2f& d,
+                     const sf::Color& color)
+{
+    // a-b-c-d in winding order, split along a-c
+    m_vertices.append(sf::Vertex(a, color));
+    m_vertices.append(sf::Vertex(b, color));
+    m_vertices.append(sf::Vertex(c, color));
+    m_vertices.append(sf::Vertex(a, color));
+    m_vertices.append(sf::Vertex(c, color));
+    m_vertices.append(sf::Vertex(d, color));
+}
+
+void DebugDraw::line(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color, float thickness)
+{
+    sf::Vector2f direction = to - from;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length <= 0.0f) {
+        return;
+    }
+    sf::Vector2f normal(-direction.y / length * thickness / 2.0f, direction.x / length * thickness / 2.0f);
+    quad(from + normal, to + normal, to - normal, from - normal, color);
+}
+
+void DebugDraw::box(const sf::FloatRect& rect, const sf::Color& outline, float thickness)
+{
+    // Four bars that don't overlap, so translucent outlines blend evenly at the corners
+    float left = rect.left - thickness;
+    float right = rect.left + rect.width;
+    float top = rect.top - thickness;
+    float bottom = rect.top + rect.height;
+    float outerWidth = rect.width + 2.0f * thickness;
+    fillBox(sf::FloatRect(left, top, outerWidth, thickness), outline);
+    fillBox(sf::FloatRect(left, bottom, outerWidth, thickness), outline);
+    fillBox(sf::FloatRect(left, rect.top, thickness, rect.height), outline);
+    fillBox(sf::FloatRect(right, rect.top, thickness, rect.height), outline);
+}
+
+void DebugDraw::fillBox(const sf::FloatRect& rect, const sf::Color& fill)
+{
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+    quad({rect.left, rect.top}, {right, rect.top}, {right, bottom}, {rect.left, bottom}, fill);
+}
+
+void DebugDraw::fillBox(const sf::FloatRect& rect, const sf::Color& fill, const sf::Color& outline, float thickness)
+{
+    fillBox(rect, fill);
+    box(rect, outline, thickness);
+}
+
+void DebugDraw::circle(const sf::Vector2f& center, float radius, const sf::Color& color, float thickness,
+                       unsigned segments)
+{
+    if (segments < 3) {
+        segments = 3;
+    }
+    // Ring of quads between the inner and outer radius
+    float inner = std::max(0.0f, radius - thickness / 2.0f);
+    float outer = radius + thickness / 2.0f;
+    float step = 2.0f * 3.14159265f / static_cast<float>(segments);
+    sf::Vector2f previous(1.0f, 0.0f);
+    for (unsigned i = 1; i <= segments; i++) {
+        sf::Vector2f current(std::cos(step * i), std::sin(step * i));
+        quad(center + previous * outer, center + current * outer, center + current * inner,
+             center + previous * inner, color);
+        previous = current;
+    }
+}
+
+void DebugDraw::flush(sf::RenderTarget& target)
+{
+    if (m_vertices.getVertexCount() > 0) {
+        target.draw(m_vertices);
+        m_vertices.clear();
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Immediate-mode debug shapes collected into one triangle array per frame
+// Queue lines, boxes and circles anywhere during rendering, then flush() draws them all
+// with a single draw call and starts over. Lines and outlines are thin quads whose
+// thickness is in world units, like sf::Shape outlines.
+class DebugDraw {
+public:
+    void line(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color, float thickness = 1.0f);
+
+    // Outline drawn outside the rect, as sf::RectangleShape does
+    void box(const sf::FloatRect& rect, const sf::Color& outline, float thickness = 1.0f);
+    void fillBox(const sf::FloatRect& rect, const sf::Color& fill);
+    void fillBox(const sf::FloatRect& rect, const sf::Color& fill, const sf::Color& outline, float thickness = 1.0f);
+
+    void circle(const sf::Vector2f& center, float radius, const sf::Color& color, float thickness = 1.0f,
+                unsigned segments = 24);
+
+    // Draws everything queued since the last flush and clears the queue
+    void flush(sf::RenderTarget& target);
+    void clear() { m_vertices.clear(); }
+
+    size_t vertexCount() const { return m_vertices.getVertexCount(); }
+
+private:
+    void quad(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Vector2f& d,
+              const sf::Color& color);
+
+    sf::VertexArray m_vertices{sf::Triangles}; // keeps its capacity across frames
+};
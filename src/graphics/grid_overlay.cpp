@@ -0,0 +1,109 @@
+#include "grid_overlay.hpp"
+#include <cmath>
+#include <cstdint>
+
+void GridOverlay::setCellSize(const sf::Vector2f& cellSize)
+{
+    m_cellSize = cellSize;
+    m_dirty = true;
+}
+
+void GridOverlay::setFont(const sf::Font& font, unsigned characterSize)
+{
+    m_font = &font;
+    m_characterSize = characterSize;
+    m_dirty = true;
+}
+
+void GridOverlay::setColor(const sf::Color& color)
+{
+    m_color = color;
+    m_dirty = true;
+}
+
+void GridOverlay::update(const sf::FloatRect& view)
+{
+    int x0 = static_cast<int>(std::floor(view.left / m_cellSize.x));
+    int y0 = static_cast<int>(std::floor(view.top / m_cellSize.y));
+    int x1 = static_cast<int>(std::floor((view.left + view.width) / m_cellSize.x));
+    int y1 = static_cast<int>(std::floor((view.top + view.height) / m_cellSize.y));
+    if (!m_dirty && x0 == m_x0 && y0 == m_y0 && x1 == m_x1 && y1 == m_y1) {
+        return;
+    }
+    m_x0 = x0;
+    m_y0 = y0;
+    m_x1 = x1;
+    m_y1 = y1;
+    rebuild();
+    m_dirty = false;
+}
+
+void GridOverlay::rebuild()
+{
+    float left = m_x0 * m_cellSize.x;
+    float top = m_y0 * m_cellSize.y;
+    float right = (m_x1 + 1) * m_cellSize.x;
+    float bottom = (m_y1 + 1) * m_cellSize.y;
+
+    // One line per cell edge across the whole range
+    m_lines.clear();
+    for (int x = m_x0; x <= m_x1 + 1; x++) {
+        m_lines.append(sf::Vertex(sf::Vector2f(x * m_cellSize.x, top), m_color));
+        m_lines.append(sf::Vertex(sf::Vector2f(x * m_cellSize.x, bottom), m_color));
+    }
+    for (int y = m_y0; y <= m_y1 + 1; y++) {
+        m_lines.append(sf::Vertex(sf::Vector2f(left, y * m_cellSize.y), m_color));
+        m_lines.append(sf::Vertex(sf::Vector2f(right, y * m_cellSize.y), m_color));
+    }
+
+    m_labels.clear();
+    int64_t cells = int64_t(m_x1 - m_x0 + 1) * (m_y1 - m_y0 + 1);
+    if (!m_font || cells > MAX_LABELED_CELLS) {
+        return;
+    }
+    for (int y = m_y0; y <= m_y1; y++) {
+        for (int x = m_x0; x <= m_x1; x++) {
+            appendLabel("(" + std::to_string(x) + ", " + std::to_string(y) + ")", x * m_cellSize.x, y * m_cellSize.y);
+        }
+    }
+}
+
+void GridOverlay::appendLabel(const std::string& label, float x, float y)
+{
+    // Same glyph layout sf::Text uses: the baseline sits one character size below the top
+    float baseline = y + static_cast<float>(m_characterSize);
+    sf::Uint32 previous = 0;
+    for (char c : label) {
+        sf::Uint32 current = static_cast<unsigned char>(c);
+        x += m_font->getKerning(previous, current, m_characterSize);
+        previous = current;
+
+        const sf::Glyph& glyph = m_font->getGlyph(current, m_characterSize, false);
+        float glyphLeft = x + glyph.bounds.left;
+        float glyphTop = baseline + glyph.bounds.top;
+        float glyphRight = glyphLeft + glyph.bounds.width;
+        float glyphBottom = glyphTop + glyph.bounds.height;
+        float u0 = static_cast<float>(glyph.textureRect.left);
+        float v0 = static_cast<float>(glyph.textureRect.top);
+        float u1 = u0 + glyph.textureRect.width;
+        float v1 = v0 + glyph.textureRect.height;
+
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphLeft, glyphTop), m_color, sf::Vector2f(u0, v0)));
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphRight, glyphTop), m_color, sf::Vector2f(u1, v0)));
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphLeft, glyphBottom), m_color, sf::Vector2f(u0, v1)));
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphLeft, glyphBottom), m_color, sf::Vector2f(u0, v1)));
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphRight, glyphTop), m_color, sf::Vector2f(u1, v0)));
+        m_labels.append(sf::Vertex(sf::Vector2f(glyphRight, glyphBottom), m_color, sf::Vector2f(u1, v1)));
+
+        x += glyph.advance;
+    }
+}
+
+void GridOverlay::draw(sf::RenderTarget& target) const
+{
+    target.draw(m_lines);
+    if (m_font && m_labels.getVertexCount() > 0) {
+        // The glyph page can grow as glyphs are added, so fetch it at draw time
+        target.draw(m_labels, sf::RenderStates(&m_font->getTexture(m_characterSize)));
+    }
+}
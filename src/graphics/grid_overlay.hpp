@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Debug overlay of cell outlines and "(x, y)" coordinate labels over the visible area
+// Lines and label glyphs are kept in two vertex arrays (two draw calls in total) and
+// only rebuilt when the range of visible cells changes, not every frame.
+class GridOverlay {
+public:
+    // Labels are skipped past this many visible cells - they'd be unreadable anyway
+    static constexpr int MAX_LABELED_CELLS = 4096;
+
+    void setCellSize(const sf::Vector2f& cellSize);
+    void setFont(const sf::Font& font, unsigned characterSize);
+    void setColor(const sf::Color& color);
+
+    // Follows the view; cheap when the visible cell range is unchanged
+    void update(const sf::FloatRect& view);
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    void rebuild();
+    void appendLabel(const std::string& label, float x, float y);
+
+    sf::Vector2f m_cellSize{64.0f, 64.0f};
+    const sf::Font* m_font = nullptr;
+    unsigned m_characterSize = 18;
+    sf::Color m_color = sf::Color::White;
+
+    // Visible cell range the arrays were built for, inclusive
+    int m_x0 = 0, m_y0 = 0, m_x1 = -1, m_y1 = -1;
+    bool m_dirty = true;
+
+    sf::VertexArray m_lines{sf::Lines};
+    sf::VertexArray m_labels{sf::Triangles};
+};
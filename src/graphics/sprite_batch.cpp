@@ -0,0 +1,114 @@
+#include "sprite_batch.hpp"
+#include "sprite_quad.hpp"
+#include <cmath>
+
+std::vector<sf::Vertex>& SpriteBatch::verticesFor(const sf::Texture* texture, const sf::Shader* shader)
+{
+    // Only a handful of textures are in flight per flush, so a linear search is enough
+    for (size_t i = 0; i < m_activeGroups; i++) {
+        if (m_groups[i].texture == texture && m_groups[i].shader == shader) {
+            return m_groups[i].vertices;
+        }
+    }
+    if (m_activeGroups == m_groups.size()) {
+        m_groups.emplace_back();
+    }
+    Group& group = m_groups[m_activeGroups++];
+    group.texture = texture;
+    group.shader = shader;
+    group.vertices.clear();
+    return group.vertices;
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, const sf::Shader* shader)
+{
+    if (const sf::Texture* texture = sprite.getTexture()) {
+        appendSpriteQuad(sprite, verticesFor(texture, shader));
+    }
+}
+
+void SpriteBatch::draw(const sf::Shape& shape, const sf::Shader* shader)
+{
+    size_t count = shape.getPointCount();
+    if (count < 3) {
+        return;
+    }
+    const sf::Transform& transform = shape.getTransform();
+    m_points.resize(count);
+    sf::Vector2f center;
+    for (size_t i = 0; i < count; i++) {
+        m_points[i] = shape.getPoint(i);
+        center += m_points[i];
+    }
+    center /= static_cast<float>(count);
+
+    std::vector<sf::Vertex>& out = verticesFor(nullptr, shader);
+
+    // Fill: a fan around the centroid (shapes are convex)
+    sf::Color fill = shape.getFillColor();
+    if (fill.a > 0) {
+        sf::Vertex middle(transform.transformPoint(center), fill);
+        for (size_t i = 0; i < count; i++) {
+            out.push_back(middle);
+            out.emplace_back(transform.transformPoint(m_points[i]), fill);
+            out.emplace_back(transform.transformPoint(m_points[(i + 1) % count]), fill);
+        }
+    }
+
+    // Outline: each point pushed out along the average of its two edge normals, as sf::Shape does
+    float thickness = shape.getOutlineThickness();
+    sf::Color outline = shape.getOutlineColor();
+    if (thickness == 0.0f || outline.a == 0) {
+        return;
+    }
+    auto edgeNormal = [&center](const sf::Vector2f& a, const sf::Vector2f& b) {
+        sf::Vector2f normal(a.y - b.y, b.x - a.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.0f) {
+            normal /= length;
+        }
+        // Point away from the shape
+        if ((a.x - center.x) * normal.x + (a.y - center.y) * normal.y < 0.0f) {
+            normal = -normal;
+        }
+        return normal;
+    };
+    auto offsetPoint = [&](size_t i) {
+        const sf::Vector2f& previous = m_points[(i + count - 1) % count];
+        const sf::Vector2f& point = m_points[i];
+        const sf::Vector2f& next = m_points[(i + 1) % count];
+        sf::Vector2f n1 = edgeNormal(previous, point);
+        sf::Vector2f n2 = edgeNormal(point, next);
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        return point + (n1 + n2) / factor * thickness;
+    };
+    sf::Vector2f firstOuter = offsetPoint(0);
+    sf::Vector2f outer = firstOuter;
+    for (size_t i = 0; i < count; i++) {
+        size_t j = (i + 1) % count;
+        sf::Vector2f nextOuter = j == 0 ? firstOuter : offsetPoint(j);
+        sf::Vertex a(transform.transformPoint(m_points[i]), outline);
+        sf::Vertex b(transform.transformPoint(outer), outline);
+        sf::Vertex c(transform.transformPoint(m_points[j]), outline);
+        sf::Vertex d(transform.transformPoint(nextOuter), outline);
+        out.insert(out.end(), {a, b, c, c, b, d});
+        outer = nextOuter;
+    }
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target)
+{
+    m_lastDrawCalls = 0;
+    for (size_t i = 0; i < m_activeGroups; i++) {
+        Group& group = m_groups[i];
+        if (group.vertices.empty()) {
+            continue;
+        }
+        sf::RenderStates states(group.texture);
+        states.shader = group.shader;
+        target.draw(group.vertices.data(), group.vertices.size(), sf::Triangles, states);
+        group.vertices.clear();
+        m_lastDrawCalls++;
+    }
+    m_activeGroups = 0;
+}
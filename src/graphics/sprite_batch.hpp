@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Collects transformed quads (and untextured shape geometry) for one pass and submits
+// one vertex array per (texture, shader) group
+// - Sprites keep their full transform (position, rotation, scale, origin), colour and
+//   texture rect, so flipped (negative width/height) frames work as with sf::Sprite
+// - Groups are emitted in the order they were first used, but everything in a group is
+//   drawn together: call flush() wherever draw order must be kept, e.g. between layers
+// Vertex storage is kept across flushes, so steady-state batching doesn't allocate.
+class SpriteBatch {
+public:
+    void draw(const sf::Sprite& sprite, const sf::Shader* shader = nullptr);
+
+    // Convex shapes (circles, rectangles, ...) with fill and outline, as sf::Shape draws them;
+    // the shape's texture is ignored
+    void draw(const sf::Shape& shape, const sf::Shader* shader = nullptr);
+
+    // Draws every group queued since the last flush, then empties the batch
+    void flush(sf::RenderTarget& target);
+
+    size_t lastDrawCalls() const { return m_lastDrawCalls; } // groups submitted by the last flush
+
+private:
+    struct Group {
+        const sf::Texture* texture = nullptr;
+        const sf::Shader* shader = nullptr;
+        std::vector<sf::Vertex> vertices; // triangles
+    };
+
+    std::vector<sf::Vertex>& verticesFor(const sf::Texture* texture, const sf::Shader* shader);
+
+    std::vector<Group> m_groups; // the first m_activeGroups are in use
+    size_t m_activeGroups = 0;
+    size_t m_lastDrawCalls = 0;
+    std::vector<sf::Vector2f> m_points; // shape scratch
+};
@@ -0,0 +1,139 @@
+#include "sprite_chunk_grid.hpp"
+#include <algorithm>
+#include <cmath>
+
+static void growBounds(sf::FloatRect& bounds, const sf::FloatRect& other)
+{
+    float left = std::min(bounds.left, other.left);
+    float top = std::min(bounds.top, other.top);
+    float right = std::max(bounds.left + bounds.width, other.left + other.width);
+    float bottom = std::max(bounds.top + bounds.height, other.top + other.height);
+    bounds = sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+void SpriteChunkGrid::clear()
+{
+    m_chunks.clear();
+    m_entries.clear();
+    m_orders.clear();
+    m_maxExtent = 0.0f;
+}
+
+uint64_t SpriteChunkGrid::chunkFor(const sf::FloatRect& bounds) const
+{
+    int cx = static_cast<int>(std::floor((bounds.left + bounds.width / 2.0f) / m_chunkSize));
+    int cy = static_cast<int>(std::floor((bounds.top + bounds.height / 2.0f) / m_chunkSize));
+    return chunkKey(cx, cy);
+}
+
+void SpriteChunkGrid::insert(uint32_t id, const sf::FloatRect& bounds)
+{
+    Entry& entry = m_entries[id];
+    entry.chunk = chunkFor(bounds);
+
+    Chunk& chunk = m_chunks[entry.chunk];
+    if (!chunk.hasBounds) {
+        chunk.bounds = bounds;
+        chunk.hasBounds = true;
+    } else {
+        growBounds(chunk.bounds, bounds);
+    }
+    chunk.orders[entry.order].push_back(id);
+
+    auto order = std::lower_bound(m_orders.begin(), m_orders.end(), entry.order);
+    if (order == m_orders.end() || *order != entry.order) {
+        m_orders.insert(order, entry.order);
+    }
+
+    m_maxExtent = std::max(m_maxExtent, std::max(bounds.width, bounds.height));
+}
+
+void SpriteChunkGrid::detach(uint32_t id)
+{
+    Entry& entry = m_entries[id];
+    auto& ids = m_chunks[entry.chunk].orders[entry.order];
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+}
+
+void SpriteChunkGrid::add(uint32_t id, sf::Sprite* sprite, int order)
+{
+    if (id >= m_entries.size()) {
+        m_entries.resize(id + 1);
+    }
+    Entry& entry = m_entries[id];
+    if (entry.live) {
+        if (entry.sprite == sprite && entry.order == order) {
+            moved(id);
+            return;
+        }
+        detach(id);
+    }
+    entry.sprite = sprite;
+    entry.order = order;
+    entry.live = true;
+    insert(id, sprite->getGlobalBounds());
+}
+
+void SpriteChunkGrid::moved(uint32_t id)
+{
+    if (id >= m_entries.size() || !m_entries[id].live) {
+        return;
+    }
+
+    Entry& entry = m_entries[id];
+    sf::FloatRect bounds = entry.sprite->getGlobalBounds();
+    if (chunkFor(bounds) == entry.chunk) {
+        // Same chunk - just make sure the chunk bounds still cover the sprite
+        growBounds(m_chunks[entry.chunk].bounds, bounds);
+        return;
+    }
+
+    // Crossed into another chunk - move it to the end of the new chunk's group
+    detach(id);
+    insert(id, bounds);
+}
+
+void SpriteChunkGrid::remove(uint32_t id)
+{
+    if (!contains(id)) {
+        return;
+    }
+    detach(id);
+    m_entries[id].live = false;
+    m_entries[id].sprite = nullptr;
+}
+
+void SpriteChunkGrid::visibleSprites(const sf::FloatRect& view, std::vector<VisibleSprite>& out) const
+{
+    // Chunks are keyed by sprite centers, so widen the search by the largest sprite
+    float margin = m_maxExtent;
+    int x0 = static_cast<int>(std::floor((view.left - margin) / m_chunkSize));
+    int y0 = static_cast<int>(std::floor((view.top - margin) / m_chunkSize));
+    int x1 = static_cast<int>(std::floor((view.left + view.width + margin) / m_chunkSize));
+    int y1 = static_cast<int>(std::floor((view.top + view.height + margin) / m_chunkSize));
+
+    m_cursors.clear();
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            auto it = m_chunks.find(chunkKey(cx, cy));
+            if (it != m_chunks.end() && it->second.hasBounds && it->second.bounds.intersects(view)) {
+                m_cursors.push_back({&it->second, it->second.orders.begin()});
+            }
+        }
+    }
+
+    // Every chunk's groups are ascending and drawn from m_orders, so stepping through the
+    // orders once and advancing each chunk's cursor on a match emits global layer order
+    out.clear();
+    for (int order : m_orders) {
+        for (Cursor& cursor : m_cursors) {
+            if (cursor.next == cursor.chunk->orders.end() || cursor.next->first != order) {
+                continue;
+            }
+            for (uint32_t id : cursor.next->second) {
+                out.push_back({order, m_entries[id].sprite});
+            }
+            ++cursor.next;
+        }
+    }
+}
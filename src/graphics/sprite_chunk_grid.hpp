@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Sprites bucketed into square world-space chunks so rendering can skip whole
+// off-screen chunks without touching their entities
+// - Each sprite lives in the chunk under the center of its global bounds
+// - Inside a chunk, sprites are grouped by render order (CLayer::getRenderOrder())
+// - Sprites are filed once and only re-filed when they cross a chunk or change order;
+//   visibleSprites() merges the visible chunks' groups back into global layer order
+//   with a linear walk (no sorting, no allocation once the output has grown)
+// Sprite pointers must stay valid while listed - call rebind() after components were
+// removed, since a pool's swap-and-pop moves its last component
+class SpriteChunkGrid {
+public:
+    struct VisibleSprite {
+        int order;
+        sf::Sprite* sprite;
+    };
+
+    explicit SpriteChunkGrid(float chunkSize = 1024.0f) : m_chunkSize(chunkSize) {}
+
+    void clear();
+
+    // List a sprite under its entity id, or re-file it if its sprite or order changed;
+    // call after the sprite has its final position
+    void add(uint32_t id, sf::Sprite* sprite, int order);
+    void remove(uint32_t id);
+    bool contains(uint32_t id) const { return id < m_entries.size() && m_entries[id].live; }
+
+    // Asks spriteFor(id) for every listed sprite's current address; ids it returns
+    // nullptr for are removed
+    template <typename Fn>
+    void rebind(Fn&& spriteFor)
+    {
+        for (uint32_t id = 0; id < m_entries.size(); id++) {
+            if (!m_entries[id].live) {
+                continue;
+            }
+            if (sf::Sprite* sprite = spriteFor(id)) {
+                m_entries[id].sprite = sprite;
+            } else {
+                remove(id);
+            }
+        }
+    }
+
+    // Re-file a sprite whose position changed (no-op for unknown ids)
+    void moved(uint32_t id);
+
+    // Sprites whose chunk intersects the view, in render order (stable within an order)
+    void visibleSprites(const sf::FloatRect& view, std::vector<VisibleSprite>& out) const;
+
+    size_t chunkCount() const { return m_chunks.size(); }
+    float chunkSize() const { return m_chunkSize; }
+
+private:
+    struct Chunk {
+        sf::FloatRect bounds;  // union of its sprites' bounds (only grows until rebuilt)
+        bool hasBounds = false;
+        std::map<int, std::vector<uint32_t>> orders; // render order -> entity ids
+    };
+
+    struct Entry {
+        sf::Sprite* sprite = nullptr;
+        int order = 0;
+        uint64_t chunk = 0;
+        bool live = false;
+    };
+
+    static uint64_t chunkKey(int cx, int cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    // A visible chunk and the next of its order groups to emit
+    struct Cursor {
+        const Chunk* chunk;
+        std::map<int, std::vector<uint32_t>>::const_iterator next;
+    };
+
+    uint64_t chunkFor(const sf::FloatRect& bounds) const;
+    void insert(uint32_t id, const sf::FloatRect& bounds);
+    void detach(uint32_t id);
+
+    float m_chunkSize;
+    float m_maxExtent = 0.0f; // largest sprite seen, widens the chunk search around the view
+    std::unordered_map<uint64_t, Chunk> m_chunks;
+    std::vector<Entry> m_entries; // indexed by entity id
+    std::vector<int> m_orders;    // every order in use, ascending
+    mutable std::vector<Cursor> m_cursors; // visibleSprites() scratch
+};
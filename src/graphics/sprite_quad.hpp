@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <vector>
+
+// Appends a sprite's quad as two triangles (6 vertices) with the same corners and
+// texture coordinates sf::Sprite draws, already run through the sprite's transform,
+// so many sprites sharing a texture can go out in one draw call
+inline void appendSpriteQuad(const sf::Sprite& sprite, std::vector<sf::Vertex>& out)
+{
+    sf::IntRect rect = sprite.getTextureRect();
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float left = static_cast<float>(rect.left);
+    float right = left + rect.width;
+    float top = static_cast<float>(rect.top);
+    float bottom = top + rect.height;
+    const sf::Transform& transform = sprite.getTransform();
+    sf::Color color = sprite.getColor();
+
+    sf::Vertex topLeft(transform.transformPoint(0, 0), color, sf::Vector2f(left, top));
+    sf::Vertex topRight(transform.transformPoint(width, 0), color, sf::Vector2f(right, top));
+    sf::Vertex bottomLeft(transform.transformPoint(0, height), color, sf::Vector2f(left, bottom));
+    sf::Vertex bottomRight(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+    out.insert(out.end(), {topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight});
+}
@@ -0,0 +1,132 @@
+#include "static_layer_cache.hpp"
+#include <cmath>
+#include <cstdio>
+
+void StaticLayerCache::clear()
+{
+    m_tiles.clear();
+    m_lastRedrawCount = 0;
+}
+
+void StaticLayerCache::setOrderLimit(int orderLimit)
+{
+    if (orderLimit != m_orderLimit) {
+        m_orderLimit = orderLimit;
+        invalidateAll();
+    }
+}
+
+void StaticLayerCache::invalidate(const sf::FloatRect& area)
+{
+    int x0 = static_cast<int>(std::floor(area.left / m_tileSize));
+    int y0 = static_cast<int>(std::floor(area.top / m_tileSize));
+    int x1 = static_cast<int>(std::floor((area.left + area.width) / m_tileSize));
+    int y1 = static_cast<int>(std::floor((area.top + area.height) / m_tileSize));
+    for (int ty = y0; ty <= y1; ty++) {
+        for (int tx = x0; tx <= x1; tx++) {
+            auto it = m_tiles.find(tileKey(tx, ty));
+            if (it != m_tiles.end()) {
+                it->second.dirty = true;
+            }
+        }
+    }
+}
+
+void StaticLayerCache::invalidateAll()
+{
+    for (auto& [key, tile] : m_tiles) {
+        tile.dirty = true;
+    }
+}
+
+void StaticLayerCache::render(Tile& tile, int tx, int ty, const TileChunkBatch& batch)
+{
+    tile.dirty = false;
+    m_lastRedrawCount++;
+
+    sf::FloatRect area(tx * m_tileSize, ty * m_tileSize, m_tileSize, m_tileSize);
+    batch.visibleMeshes(area, m_meshes);
+    bool hasContent = false;
+    for (const auto& mesh : m_meshes) {
+        hasContent = hasContent || mesh.order < m_orderLimit;
+    }
+    if (!hasContent) {
+        tile.texture.reset();
+        return;
+    }
+
+    if (!tile.texture) {
+        unsigned pixels = static_cast<unsigned>(std::ceil(m_tileSize * m_pixelsPerUnit));
+        tile.texture = std::make_unique<sf::RenderTexture>();
+        if (!tile.texture->create(pixels, pixels)) {
+            std::printf("Static layer cache: failed to create a %ux%u render texture\n", pixels, pixels);
+            tile.texture.reset();
+            return;
+        }
+    }
+
+    // Meshes come back in render order; everything outside the tile is clipped by the view
+    sf::RenderTexture& texture = *tile.texture;
+    texture.setView(sf::View(area));
+    texture.clear(sf::Color::Transparent);
+    for (const auto& mesh : m_meshes) {
+        if (mesh.order < m_orderLimit) {
+            batch.draw(texture, *mesh.mesh);
+        }
+    }
+    texture.display();
+}
+
+void StaticLayerCache::draw(sf::RenderTarget& target, const TileChunkBatch& batch, const sf::FloatRect& view)
+{
+    m_lastRedrawCount = 0;
+    int x0 = static_cast<int>(std::floor(view.left / m_tileSize));
+    int y0 = static_cast<int>(std::floor(view.top / m_tileSize));
+    int x1 = static_cast<int>(std::floor((view.left + view.width) / m_tileSize));
+    int y1 = static_cast<int>(std::floor((view.top + view.height) / m_tileSize));
+    if (x0 != m_visibleX0 || y0 != m_visibleY0 || x1 != m_visibleX1 || y1 != m_visibleY1) {
+        m_visibleX0 = x0;
+        m_visibleY0 = y0;
+        m_visibleX1 = x1;
+        m_visibleY1 = y1;
+        evictOutside(x0 - KEEP_MARGIN, y0 - KEEP_MARGIN, x1 + KEEP_MARGIN, y1 + KEEP_MARGIN);
+    }
+    for (int ty = y0; ty <= y1; ty++) {
+        for (int tx = x0; tx <= x1; tx++) {
+            Tile& tile = m_tiles[tileKey(tx, ty)];
+            if (tile.dirty) {
+                render(tile, tx, ty, batch);
+            }
+            if (!tile.texture) {
+                continue;
+            }
+            sf::Sprite sprite(tile.texture->getTexture());
+            sprite.setPosition(tx * m_tileSize, ty * m_tileSize);
+            sprite.setScale(1.0f / m_pixelsPerUnit, 1.0f / m_pixelsPerUnit);
+            target.draw(sprite);
+        }
+    }
+}
+
+void StaticLayerCache::evictOutside(int x0, int y0, int x1, int y1)
+{
+    // Dropped tiles start dirty again, so coming back just re-renders them
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        int tx = static_cast<int>(static_cast<uint32_t>(it->first >> 32));
+        int ty = static_cast<int>(static_cast<uint32_t>(it->first));
+        if (tx < x0 || tx > x1 || ty < y0 || ty > y1) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t StaticLayerCache::textureCount() const
+{
+    size_t count = 0;
+    for (const auto& [key, tile] : m_tiles) {
+        count += tile.texture ? 1 : 0;
+    }
+    return count;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "tile_chunk_batch.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Static tile layers pre-rendered into square sf::RenderTexture tiles
+// Each visible tile is rendered once from a TileChunkBatch (only meshes below an order
+// limit) and then composited as one textured quad per frame, no matter how many layers
+// and tiles it holds. Tiles are redrawn only when marked dirty; the play scene bakes
+// its level once, so it only invalidates everything when the order limit changes.
+// Trades texture memory for draw calls and CPU time: each non-empty tile within
+// KEEP_MARGIN tiles of the view holds tileSize * pixelsPerUnit squared pixels at 4 bytes
+// each (4 MB at the defaults); tiles further away are freed when the view moves.
+class StaticLayerCache {
+public:
+    explicit StaticLayerCache(float tileSize = 1024.0f, float pixelsPerUnit = 1.0f)
+        : m_tileSize(tileSize), m_pixelsPerUnit(pixelsPerUnit) {}
+
+    void clear();
+
+    // Meshes with a render order below this are cached (and must be skipped when drawing
+    // the batch directly); changing it invalidates every tile
+    void setOrderLimit(int orderLimit);
+    int orderLimit() const { return m_orderLimit; }
+
+    // Marks the tiles overlapping a world rectangle for redrawing on their next draw
+    void invalidate(const sf::FloatRect& area);
+    void invalidateAll();
+
+    // Re-renders dirty visible tiles from the batch, then draws every visible tile
+    void draw(sf::RenderTarget& target, const TileChunkBatch& batch, const sf::FloatRect& view);
+
+    size_t textureCount() const;
+    size_t lastRedrawCount() const { return m_lastRedrawCount; } // tiles re-rendered by the last draw()
+
+private:
+    struct Tile {
+        std::unique_ptr<sf::RenderTexture> texture; // null while the tile holds nothing
+        bool dirty = true;
+    };
+
+    static uint64_t tileKey(int tx, int ty)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32) | static_cast<uint32_t>(ty);
+    }
+
+    void render(Tile& tile, int tx, int ty, const TileChunkBatch& batch);
+    void evictOutside(int x0, int y0, int x1, int y1);
+
+    // Tiles kept around the visible range, so small camera moves don't re-render
+    static constexpr int KEEP_MARGIN = 1;
+
+    float m_tileSize;
+    float m_pixelsPerUnit;
+    int m_orderLimit = 0;
+    size_t m_lastRedrawCount = 0;
+    int m_visibleX0 = 0, m_visibleY0 = 0, m_visibleX1 = -1, m_visibleY1 = -1; // last drawn tile range
+    std::unordered_map<uint64_t, Tile> m_tiles;
+    std::vector<TileChunkBatch::VisibleMesh> m_meshes; // render() scratch
+};
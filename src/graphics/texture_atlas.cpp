@@ -0,0 +1,118 @@
+#include "texture_atlas.hpp"
+#include <algorithm>
+#include <cstdio>
+
+// Private copy of the packer - Dear ImGui builds its own static copy the same way
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+void TextureAtlas::clear()
+{
+    m_pages.clear();
+    m_regions.clear();
+}
+
+void TextureAtlas::build(const std::map<std::string, sf::Texture>& textures, unsigned pageSize,
+                         unsigned maxRegionSize)
+{
+    clear();
+
+    struct Input {
+        const std::string* name;
+        sf::Image image;
+    };
+    std::vector<Input> inputs;
+    for (const auto& [name, texture] : textures) {
+        sf::Vector2u size = texture.getSize();
+        if (size.x == 0 || size.y == 0 || size.x > maxRegionSize || size.y > maxRegionSize ||
+            size.x + 2 * PADDING > pageSize || size.y + 2 * PADDING > pageSize) {
+            continue;
+        }
+        inputs.push_back({&name, texture.copyToImage()});
+    }
+
+    std::vector<stbrp_rect> pending;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        stbrp_rect rect{};
+        rect.id = static_cast<int>(i);
+        rect.w = static_cast<int>(inputs[i].image.getSize().x) + 2 * PADDING;
+        rect.h = static_cast<int>(inputs[i].image.getSize().y) + 2 * PADDING;
+        pending.push_back(rect);
+    }
+
+    std::vector<stbrp_node> nodes(pageSize);
+    while (!pending.empty()) {
+        stbrp_context context;
+        stbrp_init_target(&context, static_cast<int>(pageSize), static_cast<int>(pageSize), nodes.data(),
+                          static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+        std::vector<stbrp_rect> packed, rest;
+        unsigned usedHeight = 0;
+        for (const stbrp_rect& rect : pending) {
+            if (rect.was_packed) {
+                packed.push_back(rect);
+                usedHeight = std::max(usedHeight, static_cast<unsigned>(rect.y + rect.h));
+            } else {
+                rest.push_back(rect);
+            }
+        }
+        if (packed.empty()) {
+            break; // nothing more fits even on an empty page
+        }
+
+        // Only as tall as the packed rows need
+        sf::Image page;
+        page.create(pageSize, usedHeight, sf::Color::Transparent);
+        for (const stbrp_rect& rect : packed) {
+            const sf::Image& image = inputs[rect.id].image;
+            unsigned width = image.getSize().x;
+            unsigned height = image.getSize().y;
+            unsigned left = static_cast<unsigned>(rect.x + PADDING);
+            unsigned top = static_cast<unsigned>(rect.y + PADDING);
+            page.copy(image, left, top);
+
+            // Extrude the edge pixels into the padding, corners included
+            for (unsigned y = 0; y < height; y++) {
+                page.setPixel(left - 1, top + y, image.getPixel(0, y));
+                page.setPixel(left + width, top + y, image.getPixel(width - 1, y));
+            }
+            for (unsigned x = left - 1; x <= left + width; x++) {
+                page.setPixel(x, top - 1, page.getPixel(x, top));
+                page.setPixel(x, top + height, page.getPixel(x, top + height - 1));
+            }
+        }
+
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(page)) {
+            std::printf("Texture atlas: failed to create page %zu\n", m_pages.size());
+            break;
+        }
+        for (const stbrp_rect& rect : packed) {
+            const sf::Image& image = inputs[rect.id].image;
+            m_regions[*inputs[rect.id].name] = {
+                texture.get(),
+                sf::IntRect(rect.x + PADDING, rect.y + PADDING, static_cast<int>(image.getSize().x),
+                            static_cast<int>(image.getSize().y))};
+        }
+        m_pages.push_back(std::move(texture));
+        pending.swap(rest);
+    }
+
+    std::printf("Texture atlas: packed %zu of %zu textures into %zu page(s)\n", m_regions.size(), textures.size(),
+                m_pages.size());
+}
+
+const TextureRegion* TextureAtlas::find(const std::string& name) const
+{
+    auto it = m_regions.find(name);
+    return it == m_regions.end() ? nullptr : &it->second;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A texture plus the sub-rectangle to sample from it - either a region of an atlas
+// page or a whole standalone texture
+struct TextureRegion {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+
+    // Points a sprite at the region (texture and texture rect)
+    void applyTo(sf::Sprite& sprite) const
+    {
+        sprite.setTexture(*texture);
+        sprite.setTextureRect(rect);
+    }
+};
+
+// Small textures packed into a few large pages at load so sprites and tile meshes that
+// use different images can share one texture (and one draw call)
+// - Packing uses the rect packer bundled with Dear ImGui (imstb_rectpack)
+// - Every region gets a one pixel border copied from its own edge pixels, so scaled
+//   sprites never sample their neighbours on the page
+// - Textures larger than maxRegionSize, or that don't fit on a page, are left out;
+//   callers fall back to the standalone texture
+class TextureAtlas {
+public:
+    void clear();
+
+    // Packs the textures into pages of pageSize x pageSize (needs a GL context, like any texture load)
+    void build(const std::map<std::string, sf::Texture>& textures, unsigned pageSize = 1024,
+               unsigned maxRegionSize = 512);
+
+    // Region of a packed texture, or nullptr if it wasn't packed
+    const TextureRegion* find(const std::string& name) const;
+
+    size_t pageCount() const { return m_pages.size(); }
+    size_t regionCount() const { return m_regions.size(); }
+
+private:
+    static constexpr int PADDING = 1;
+
+    std::vector<std::unique_ptr<sf::Texture>> m_pages; // stable addresses for sprites
+    std::map<std::string, TextureRegion> m_regions;
+};
@@ -0,0 +1,126 @@
+#include "tile_chunk_batch.hpp"
+#include "sprite_quad.hpp"
+#include <algorithm>
+#include <cmath>
+
+void TileChunkBatch::clear()
+{
+    m_chunks.clear();
+    m_orders.clear();
+    m_maxExtent = 0.0f;
+    m_useBuffers = false;
+    m_tileCount = 0;
+}
+
+void TileChunkBatch::add(const sf::Sprite& sprite, int order)
+{
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) {
+        return;
+    }
+
+    sf::FloatRect bounds = sprite.getGlobalBounds();
+    int cx = static_cast<int>(std::floor((bounds.left + bounds.width / 2.0f) / m_chunkSize));
+    int cy = static_cast<int>(std::floor((bounds.top + bounds.height / 2.0f) / m_chunkSize));
+    Chunk& chunk = m_chunks[chunkKey(cx, cy)];
+    if (!chunk.hasBounds) {
+        chunk.bounds = bounds;
+        chunk.hasBounds = true;
+    } else {
+        float left = std::min(chunk.bounds.left, bounds.left);
+        float top = std::min(chunk.bounds.top, bounds.top);
+        float right = std::max(chunk.bounds.left + chunk.bounds.width, bounds.left + bounds.width);
+        float bottom = std::max(chunk.bounds.top + chunk.bounds.height, bounds.top + bounds.height);
+        chunk.bounds = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+    m_maxExtent = std::max(m_maxExtent, std::max(bounds.width, bounds.height));
+
+    // A layer holds only a few distinct textures per chunk, so a linear search is enough
+    auto& meshes = chunk.orders[order];
+    auto knownOrder = std::lower_bound(m_orders.begin(), m_orders.end(), order);
+    if (knownOrder == m_orders.end() || *knownOrder != order) {
+        m_orders.insert(knownOrder, order);
+    }
+    auto mesh = std::find_if(meshes.begin(), meshes.end(), [&](const Mesh& m) { return m.texture == texture; });
+    if (mesh == meshes.end()) {
+        meshes.emplace_back();
+        mesh = meshes.end() - 1;
+        mesh->texture = texture;
+    }
+
+    appendSpriteQuad(sprite, mesh->vertices);
+    m_tileCount++;
+}
+
+void TileChunkBatch::upload()
+{
+    m_useBuffers = sf::VertexBuffer::isAvailable();
+    if (!m_useBuffers) {
+        return;
+    }
+    for (auto& [key, chunk] : m_chunks) {
+        for (auto& [order, meshes] : chunk.orders) {
+            for (Mesh& mesh : meshes) {
+                if (!mesh.buffer.create(mesh.vertices.size()) || !mesh.buffer.update(mesh.vertices.data())) {
+                    m_useBuffers = false;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void TileChunkBatch::visibleMeshes(const sf::FloatRect& view, std::vector<VisibleMesh>& out) const
+{
+    out.clear();
+
+    // Chunks are keyed by tile centers, so widen the search by the largest tile
+    float margin = m_maxExtent;
+    int x0 = static_cast<int>(std::floor((view.left - margin) / m_chunkSize));
+    int y0 = static_cast<int>(std::floor((view.top - margin) / m_chunkSize));
+    int x1 = static_cast<int>(std::floor((view.left + view.width + margin) / m_chunkSize));
+    int y1 = static_cast<int>(std::floor((view.top + view.height + margin) / m_chunkSize));
+    m_cursors.clear();
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            auto it = m_chunks.find(chunkKey(cx, cy));
+            if (it != m_chunks.end() && it->second.bounds.intersects(view)) {
+                m_cursors.push_back({&it->second, it->second.orders.begin()});
+            }
+        }
+    }
+
+    // Same order-by-order merge as SpriteChunkGrid::visibleSprites()
+    for (int order : m_orders) {
+        for (Cursor& cursor : m_cursors) {
+            if (cursor.next == cursor.chunk->orders.end() || cursor.next->first != order) {
+                continue;
+            }
+            for (const Mesh& mesh : cursor.next->second) {
+                out.push_back({order, &mesh});
+            }
+            ++cursor.next;
+        }
+    }
+}
+
+void TileChunkBatch::draw(sf::RenderTarget& target, const Mesh& mesh) const
+{
+    sf::RenderStates states(mesh.texture);
+    if (m_useBuffers) {
+        target.draw(mesh.buffer, states);
+    } else {
+        target.draw(mesh.vertices.data(), mesh.vertices.size(), sf::Triangles, states);
+    }
+}
+
+size_t TileChunkBatch::meshCount() const
+{
+    size_t count = 0;
+    for (const auto& [key, chunk] : m_chunks) {
+        for (const auto& [order, meshes] : chunk.orders) {
+            count += meshes.size();
+        }
+    }
+    return count;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Static level tiles baked into vertex buffers, one mesh per (chunk, render order, texture)
+// Drawing a visible chunk costs one draw call per texture per layer instead of one per
+// tile. Baked geometry never changes: bake once per level, after every tile sprite has
+// its final position, scale and rotation.
+class TileChunkBatch {
+public:
+    struct Mesh {
+        const sf::Texture* texture = nullptr;
+        std::vector<sf::Vertex> vertices; // two triangles per tile
+        sf::VertexBuffer buffer{sf::Triangles, sf::VertexBuffer::Static};
+    };
+
+    struct VisibleMesh {
+        int order;
+        const Mesh* mesh;
+    };
+
+    explicit TileChunkBatch(float chunkSize = 1024.0f) : m_chunkSize(chunkSize) {}
+
+    void clear();
+
+    // Adds a sprite's quad (with its current transform) to the mesh for its chunk/order/texture
+    void add(const sf::Sprite& sprite, int order);
+
+    // Moves every mesh into a static GPU buffer; falls back to client-side vertices
+    // when the driver has no vertex buffer support
+    void upload();
+
+    // Meshes of the chunks that intersect the view, in render order (merged, not sorted)
+    void visibleMeshes(const sf::FloatRect& view, std::vector<VisibleMesh>& out) const;
+
+    void draw(sf::RenderTarget& target, const Mesh& mesh) const;
+
+    size_t meshCount() const;
+    size_t tileCount() const { return m_tileCount; }
+
+private:
+    struct Chunk {
+        sf::FloatRect bounds; // union of its tiles' bounds
+        bool hasBounds = false;
+        std::map<int, std::vector<Mesh>> orders; // render order -> one mesh per texture
+    };
+
+    // A visible chunk and the next of its order groups to emit
+    struct Cursor {
+        const Chunk* chunk;
+        std::map<int, std::vector<Mesh>>::const_iterator next;
+    };
+
+    static uint64_t chunkKey(int cx, int cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    float m_chunkSize;
+    float m_maxExtent = 0.0f; // largest tile seen, widens the chunk search around the view
+    bool m_useBuffers = false;
+    size_t m_tileCount = 0;
+    std::unordered_map<uint64_t, Chunk> m_chunks;
+    std::vector<int> m_orders; // every order in use, ascending
+    mutable std::vector<Cursor> m_cursors; // visibleMeshes() scratch
+};
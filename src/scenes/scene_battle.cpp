@@ -438,7 +438,7 @@ void Scene_Battle::renderPartyMembers(const sf::RectangleShape& area) {
         character.setOutlineColor(outlineColor);
         character.setOutlineThickness(outlineThickness);
         
-        m_game->window().draw(character);
+        m_batch.draw(character);
         
         // Character name and HP (adjust positions for larger portraits)
         try {
@@ -463,19 +463,23 @@ void Scene_Battle::renderPartyMembers(const sf::RectangleShape& area) {
             hpBar.setSize(sf::Vector2f(80, 6));
             hpBar.setPosition(x + 90, y + 50); // Adjusted for larger portrait
             hpBar.setFillColor(sf::Color::Red);
-            m_game->window().draw(hpBar);
+            m_batch.draw(hpBar);
             
             sf::RectangleShape hpFill;
             float hpRatio = (float)member.currentHP / member.maxHP;
             hpFill.setSize(sf::Vector2f(80 * hpRatio, 6));
             hpFill.setPosition(x + 90, y + 50); // Adjusted for larger portrait
             hpFill.setFillColor(sf::Color::Green);
-            m_game->window().draw(hpFill);
+            m_batch.draw(hpFill);
             
         } catch (const std::exception& e) {
             // Ignore font errors
         }
     }
+    
+    // Portraits and HP bars never overlap the name/HP text, so queuing them past it and
+    // drawing them together doesn't change the picture
+    m_batch.flush(m_game->window());
 }
 
 void Scene_Battle::renderEnemies(const sf::RectangleShape& area) {
@@ -518,7 +522,7 @@ void Scene_Battle::renderEnemies(const sf::RectangleShape& area) {
         enemyShape.setOutlineColor(outlineColor);
         enemyShape.setOutlineThickness(outlineThickness);
         
-        m_game->window().draw(enemyShape);
+        m_batch.draw(enemyShape);
         
         // Enemy name and HP (adjust positions for larger portraits)
         try {
@@ -543,19 +547,22 @@ void Scene_Battle::renderEnemies(const sf::RectangleShape& area) {
             hpBar.setSize(sf::Vector2f(60, 6));
             hpBar.setPosition(x + 80, y + 50); // Adjusted for larger portrait
             hpBar.setFillColor(sf::Color::Red);
-            m_game->window().draw(hpBar);
+            m_batch.draw(hpBar);
             
             sf::RectangleShape hpFill;
             float hpRatio = (float)enemy.currentHP / enemy.maxHP;
             hpFill.setSize(sf::Vector2f(60 * hpRatio, 6));
             hpFill.setPosition(x + 80, y + 50); // Adjusted for larger portrait
             hpFill.setFillColor(sf::Color(255, 165, 0)); // Orange color
-            m_game->window().draw(hpFill);
+            m_batch.draw(hpFill);
             
         } catch (const std::exception& e) {
             // Ignore font errors
         }
     }
+    
+    // One draw for every enemy shape and bar, as in renderPartyMembers
+    m_batch.flush(m_game->window());
 }
 
 sf::Color Scene_Battle::getCharacterColor(const std::string& name) {
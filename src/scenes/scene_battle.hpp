@@ -1,6 +1,7 @@
 #pragma once
 #include "scene.hpp"
 #include "../components.hpp"
+#include "../graphics/sprite_batch.hpp"
 #include <vector>
 #include <memory>
 #include <queue>
@@ -23,7 +24,7 @@ public:
   enum class BattleAction { ATTACK, DEFEND, ITEM, SPELL, FLEE };
 
   struct BattleCharacter {
-    std::shared_ptr<Entity> entity;
+    Entity entity;
     std::string name;
     int currentHP;
     int maxHP;
@@ -139,12 +140,13 @@ protected:
   bool m_preserveState;
 
   // Visual elements
-  std::shared_ptr<Entity> m_background;
-  std::shared_ptr<Entity> m_uiPanel;
+  Entity m_background;
+  Entity m_uiPanel;
   sf::Text m_actionText;
   sf::Text m_statusText;
   sf::Text m_damageText;
   sf::Font m_font;
+  SpriteBatch m_batch; // party/enemy shapes and HP bars, one draw per render pass
 
   // Timing
   sf::Clock m_deltaClock;
@@ -1,4 +1,5 @@
 #include "scene_grid_map_editor.hpp"
+#include "../graphics/sprite_quad.hpp"
 #include "scene_menu.hpp"
 #include "scene_loading.hpp"
 #include "../game_engine.hpp"
@@ -109,6 +110,7 @@ void Scene_GridMapEditor::init()
     
     // Clear infinite grid (it starts empty by default)
     m_infiniteGrid.clear();
+    m_renderChunks.clear();
     
     std::cout << "Levels: metadata/levels/ | Config: metadata/\n";
 }
@@ -178,6 +180,7 @@ void Scene_GridMapEditor::loadAssetProperties()
             props.defaultRotation = rotation;
             
             m_assetProperties[assetName] = props;
+            m_maxAssetCells = std::max(m_maxAssetCells, std::max(width, height));
             std::cout << "Loaded properties for " << assetName << ": " 
                       << width << "x" << height << ", collision=" << collision 
                       << ", rotation=" << rotation << std::endl;
@@ -384,6 +387,7 @@ Scene_GridMapEditor::GridCell* Scene_GridMapEditor::getGridCell(int x, int y)
 
 void Scene_GridMapEditor::setGridCell(int x, int y, const GridCell& cell)
 {
+    invalidateRenderChunk(x, y);
     auto posKey = std::make_pair(x, y);
     if (cell.occupied) {
         m_infiniteGrid[posKey][m_currentLayer] = cell;
@@ -512,6 +516,7 @@ void Scene_GridMapEditor::removeObject()
                       << ") with origin at (" << originX << ", " << originY << ")" << std::endl;
         } else {
             // Single cell asset - remove just this cell
+            invalidateRenderChunk(x, y);
             m_infiniteGrid[cellKey].erase(m_currentLayer);
             
             // If no layers remain for this cell, remove the cell entirely
@@ -739,6 +744,10 @@ void Scene_GridMapEditor::saveLevel(const std::string& filename)
     file << "# Enhanced Format: Layer SpriteName X Y [Collision] [Rotation] [Width] [Height] [OriginX] [OriginY]\n";
     file << "# Collision: 0=false, 1=true | Rotation: degrees | Width/Height: grid cells | OriginX/Y: multi-cell origin\n\n";
     
+    for (const auto& option : m_levelOptions) {
+        file << option << "\n";
+    }
+    
     // Save all placed objects from infinite grid
     int objectCount = 0;
     for (const auto& posPair : m_infiniteGrid) {
@@ -796,6 +805,8 @@ void Scene_GridMapEditor::loadLevel(const std::string& filename)
     
     // Clear current infinite grid
     m_infiniteGrid.clear();
+    m_renderChunks.clear();
+    m_levelOptions.clear();
     
     std::string line;
     int objectCount = 0;
@@ -805,6 +816,12 @@ void Scene_GridMapEditor::loadLevel(const std::string& filename)
             continue;
         }
         
+        // Level options (e.g. "Option StaticLayerCache 1") are kept as-is for saving
+        if (line.rfind("Option ", 0) == 0) {
+            m_levelOptions.push_back(line);
+            continue;
+        }
+        
         std::istringstream iss(line);
         std::string type, asset;
         int x, y;
@@ -898,12 +915,14 @@ void Scene_GridMapEditor::sRender()
     if (m_showAxis) {
         drawAxis();
     }
+    m_debugDraw.flush(m_game->window());
     
     drawPlacedObjects();
     
     // Draw collision overlay if enabled
     if (m_showCollision) {
         drawCollisionOverlay();
+        m_debugDraw.flush(m_game->window());
     }
     
     // Draw asset size preview
@@ -934,20 +953,17 @@ void Scene_GridMapEditor::drawInfiniteGrid()
     Vec2 gridMin = getVisibleGridMin();
     Vec2 gridMax = getVisibleGridMax();
     
-    // Draw vertical grid lines
+    // Grid lines are queued on m_debugDraw and drawn together by sRender()
+    const sf::Color lineColor(80, 80, 80, 100);
+    
+    // Vertical grid lines
     for (int x = static_cast<int>(gridMin.x); x <= static_cast<int>(gridMax.x); x++) {
-        sf::RectangleShape line(sf::Vector2f(1, (gridMax.y - gridMin.y + 1) * TILE_SIZE));
-        line.setPosition(x * TILE_SIZE, gridMin.y * TILE_SIZE);
-        line.setFillColor(sf::Color(80, 80, 80, 100));
-        m_game->window().draw(line);
+        m_debugDraw.fillBox(sf::FloatRect(x * TILE_SIZE, gridMin.y * TILE_SIZE, 1, (gridMax.y - gridMin.y + 1) * TILE_SIZE), lineColor);
     }
     
-    // Draw horizontal grid lines
+    // Horizontal grid lines
     for (int y = static_cast<int>(gridMin.y); y <= static_cast<int>(gridMax.y); y++) {
-        sf::RectangleShape line(sf::Vector2f((gridMax.x - gridMin.x + 1) * TILE_SIZE, 1));
-        line.setPosition(gridMin.x * TILE_SIZE, y * TILE_SIZE);
-        line.setFillColor(sf::Color(80, 80, 80, 100));
-        m_game->window().draw(line);
+        m_debugDraw.fillBox(sf::FloatRect(gridMin.x * TILE_SIZE, y * TILE_SIZE, (gridMax.x - gridMin.x + 1) * TILE_SIZE, 1), lineColor);
     }
     
     // Cursor is now drawn separately in sRender() to ensure it's always on top
@@ -964,10 +980,7 @@ void Scene_GridMapEditor::drawAxis()
         float startX = gridMin.x * TILE_SIZE;
         float endX = gridMax.x * TILE_SIZE;
         
-        sf::RectangleShape xAxis(sf::Vector2f(endX - startX, 2));
-        xAxis.setPosition(startX, axisY);
-        xAxis.setFillColor(sf::Color::Red);
-        m_game->window().draw(xAxis);
+        m_debugDraw.fillBox(sf::FloatRect(startX, axisY, endX - startX, 2), sf::Color::Red);
         
         // Draw X-axis labels and symbols
         sf::Text xLabel;
@@ -1003,10 +1016,7 @@ void Scene_GridMapEditor::drawAxis()
         float startY = gridMin.y * TILE_SIZE;
         float endY = gridMax.y * TILE_SIZE;
         
-        sf::RectangleShape yAxis(sf::Vector2f(2, endY - startY));
-        yAxis.setPosition(axisX, startY);
-        yAxis.setFillColor(sf::Color::Green);
-        m_game->window().draw(yAxis);
+        m_debugDraw.fillBox(sf::FloatRect(axisX, startY, 2, endY - startY), sf::Color::Green);
         
         // Draw Y-axis labels and symbols
         sf::Text yLabel;
@@ -1030,146 +1040,163 @@ void Scene_GridMapEditor::drawAxis()
     }
 }
 
+static uint64_t renderChunkKey(int chunkX, int chunkY)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+
+static int renderChunkOf(int cell, int chunkCells)
+{
+    return cell >= 0 ? cell / chunkCells : (cell + 1) / chunkCells - 1;
+}
+
+void Scene_GridMapEditor::invalidateRenderChunk(int x, int y)
+{
+    auto it = m_renderChunks.find(renderChunkKey(renderChunkOf(x, RENDER_CHUNK_CELLS), renderChunkOf(y, RENDER_CHUNK_CELLS)));
+    if (it != m_renderChunks.end()) {
+        it->second.dirty = true;
+    }
+}
+
+void Scene_GridMapEditor::rebuildRenderChunk(int chunkX, int chunkY, RenderChunk& chunk)
+{
+    for (auto& meshes : chunk.layers) {
+        meshes.clear();
+    }
+    
+    // m_infiniteGrid is ordered by x then y, so each column of the chunk is one range
+    int x0 = chunkX * RENDER_CHUNK_CELLS;
+    int y0 = chunkY * RENDER_CHUNK_CELLS;
+    for (int x = x0; x < x0 + RENDER_CHUNK_CELLS; x++) {
+        auto posIt = m_infiniteGrid.lower_bound(std::make_pair(x, y0));
+        for (; posIt != m_infiniteGrid.end() && posIt->first.first == x && posIt->first.second < y0 + RENDER_CHUNK_CELLS; ++posIt) {
+            int y = posIt->first.second;
+            for (const auto& [layer, cell] : posIt->second) {
+                if (layer < 0 || layer >= static_cast<int>(chunk.layers.size()) || !cell.occupied) {
+                    continue;
+                }
+                
+                // Multi-cell assets are cached once, with their origin cell
+                const AssetProperties& props = getAssetProperties(cell.asset);
+                bool isMultiCell = (props.width > 1 || props.height > 1);
+                if (isMultiCell && (x != cell.originX || y != cell.originY)) {
+                    continue;
+                }
+                
+                // Calculate the actual occupied area dimensions after rotation
+                int occupiedWidth = isMultiCell ? props.width : 1;
+                int occupiedHeight = isMultiCell ? props.height : 1;
+                bool quarterTurn = (cell.rotation == 90.0f || cell.rotation == 270.0f);
+                if (quarterTurn) {
+                    std::swap(occupiedWidth, occupiedHeight);
+                }
+                
+                auto& meshes = chunk.layers[layer];
+                auto meshFor = [&meshes](const sf::Texture* texture) -> RenderMesh& {
+                    for (RenderMesh& mesh : meshes) {
+                        if (mesh.texture == texture) {
+                            return mesh;
+                        }
+                    }
+                    meshes.push_back({texture, {}});
+                    return meshes.back();
+                };
+                
+                TextureRegion region;
+                try {
+                    region = m_game->getAssets().getTextureRegion(cell.asset);
+                } catch (...) {
+                    // If texture not found, cache a magenta rectangle over the asset's area
+                    sf::Sprite placeholder;
+                    placeholder.setTextureRect(sf::IntRect(0, 0, props.width * TILE_SIZE, props.height * TILE_SIZE));
+                    placeholder.setPosition(x * TILE_SIZE, y * TILE_SIZE);
+                    placeholder.setColor(sf::Color::Magenta);
+                    appendSpriteQuad(placeholder, meshFor(nullptr).vertices);
+                    continue;
+                }
+                
+                sf::Sprite sprite;
+                region.applyTo(sprite);
+                float textureWidth = static_cast<float>(region.rect.width);
+                float textureHeight = static_cast<float>(region.rect.height);
+                
+                // Scale to fit the occupied area; 90/270 degree rotations swap the scaling
+                if (quarterTurn) {
+                    sprite.setScale(occupiedWidth * TILE_SIZE / textureHeight, occupiedHeight * TILE_SIZE / textureWidth);
+                } else {
+                    sprite.setScale(occupiedWidth * TILE_SIZE / textureWidth, occupiedHeight * TILE_SIZE / textureHeight);
+                }
+                
+                if (cell.rotation != 0.0f) {
+                    // Rotate around the texture center, positioned at the center of the occupied area
+                    sprite.setOrigin(textureWidth / 2.0f, textureHeight / 2.0f);
+                    sprite.setRotation(cell.rotation);
+                    sprite.setPosition(x * TILE_SIZE + (occupiedWidth * TILE_SIZE) / 2.0f,
+                                       y * TILE_SIZE + (occupiedHeight * TILE_SIZE) / 2.0f);
+                } else {
+                    // No rotation - position at top-left
+                    sprite.setPosition(x * TILE_SIZE, y * TILE_SIZE);
+                }
+                
+                appendSpriteQuad(sprite, meshFor(region.texture).vertices);
+            }
+        }
+    }
+    
+    chunk.dirty = false;
+    chunk.tintedLayer = -1;
+}
+
+void Scene_GridMapEditor::tintRenderChunk(RenderChunk& chunk)
+{
+    // Add slight transparency to non-current layers for visual feedback
+    for (size_t layer = 0; layer < chunk.layers.size(); layer++) {
+        sf::Uint8 alpha = static_cast<int>(layer) == m_currentLayer ? 255 : 180;
+        for (RenderMesh& mesh : chunk.layers[layer]) {
+            for (sf::Vertex& vertex : mesh.vertices) {
+                vertex.color.a = alpha;
+            }
+        }
+    }
+    chunk.tintedLayer = m_currentLayer;
+}
+
 void Scene_GridMapEditor::drawPlacedObjects()
 {
     Vec2 gridMin = getVisibleGridMin();
     Vec2 gridMax = getVisibleGridMax();
     
-    // Keep track of multi-cell assets we've already drawn to avoid duplicates
-    std::set<std::string> drawnAssets; // Use unique identifier for each asset instance
+    // Widen the chunk range so objects whose origin is off-screen but that reach into
+    // view are still drawn
+    int margin = m_maxAssetCells - 1;
+    int chunkX0 = renderChunkOf(static_cast<int>(gridMin.x) - margin, RENDER_CHUNK_CELLS);
+    int chunkY0 = renderChunkOf(static_cast<int>(gridMin.y) - margin, RENDER_CHUNK_CELLS);
+    int chunkX1 = renderChunkOf(static_cast<int>(gridMax.x), RENDER_CHUNK_CELLS);
+    int chunkY1 = renderChunkOf(static_cast<int>(gridMax.y), RENDER_CHUNK_CELLS);
+    
+    // Bring visible chunks up to date (empty chunks are cached too, so a scan over
+    // empty space happens once)
+    m_visibleRenderChunks.clear();
+    for (int chunkX = chunkX0; chunkX <= chunkX1; chunkX++) {
+        for (int chunkY = chunkY0; chunkY <= chunkY1; chunkY++) {
+            RenderChunk& chunk = m_renderChunks[renderChunkKey(chunkX, chunkY)];
+            if (chunk.dirty) {
+                rebuildRenderChunk(chunkX, chunkY, chunk);
+            }
+            if (chunk.tintedLayer != m_currentLayer) {
+                tintRenderChunk(chunk);
+            }
+            m_visibleRenderChunks.push_back(&chunk);
+        }
+    }
     
-    // Render layers in order (0-4) for proper layering
+    // Render layers in order (0-4) for proper layering - one draw per chunk, layer and texture
     for (int layer = 0; layer <= 4; layer++) {
-        // Only draw objects in visible area for performance
-        for (int x = static_cast<int>(gridMin.x); x <= static_cast<int>(gridMax.x); x++) {
-            for (int y = static_cast<int>(gridMin.y); y <= static_cast<int>(gridMax.y); y++) {
-                auto posKey = std::make_pair(x, y);
-                auto posIt = m_infiniteGrid.find(posKey);
-                if (posIt != m_infiniteGrid.end()) {
-                    auto layerIt = posIt->second.find(layer);
-                    if (layerIt != posIt->second.end() && layerIt->second.occupied) {
-                        GridCell& cell = layerIt->second;
-                        
-                        // For multi-cell assets, only draw once at the origin cell
-                        AssetProperties props = getAssetProperties(cell.asset);
-                        bool isMultiCell = (props.width > 1 || props.height > 1);
-                        
-                        if (isMultiCell) {
-                            // Check if this is the origin cell
-                            bool isOriginCell = (x == cell.originX && y == cell.originY);
-                            
-                            if (!isOriginCell) continue; // Skip non-origin cells
-                            
-                            // Create unique identifier for this asset instance
-                            std::string assetId = std::to_string(layer) + "_" + 
-                                                std::to_string(cell.originX) + "_" + 
-                                                std::to_string(cell.originY) + "_" + 
-                                                cell.asset;
-                            
-                            // Check if we've already drawn this asset instance
-                            if (drawnAssets.find(assetId) != drawnAssets.end()) continue;
-                            drawnAssets.insert(assetId);
-                        }
-                        
-                        // Try to get the texture for this asset
-                        try {
-                            const sf::Texture& texture = m_game->getAssets().getTexture(cell.asset);
-                            sf::Sprite sprite(texture);
-                            
-                            if (isMultiCell) {
-                                // For multi-cell assets, scale to fit the entire asset area
-                                sf::Vector2u textureSize = texture.getSize();
-                                
-                                // Calculate the actual occupied area dimensions after rotation
-                                int occupiedWidth = props.width;
-                                int occupiedHeight = props.height;
-                                if (cell.rotation == 90.0f || cell.rotation == 270.0f) {
-                                    std::swap(occupiedWidth, occupiedHeight);
-                                }
-                                
-                                // For rotated assets, we need to handle scaling differently
-                                if (cell.rotation == 90.0f || cell.rotation == 270.0f) {
-                                    // For 90/270 degree rotations, swap the scaling
-                                    float scaleX = static_cast<float>(occupiedWidth * TILE_SIZE) / textureSize.y;
-                                    float scaleY = static_cast<float>(occupiedHeight * TILE_SIZE) / textureSize.x;
-                                    sprite.setScale(scaleX, scaleY);
-                                } else {
-                                    // For 0/180 degree rotations, use normal scaling
-                                    float scaleX = static_cast<float>(occupiedWidth * TILE_SIZE) / textureSize.x;
-                                    float scaleY = static_cast<float>(occupiedHeight * TILE_SIZE) / textureSize.y;
-                                    sprite.setScale(scaleX, scaleY);
-                                }
-                                
-                                // Set rotation and origin for proper rotation around center
-                                if (cell.rotation != 0.0f) {
-                                    // Set origin to center of the texture
-                                    sprite.setOrigin(textureSize.x / 2.0f, textureSize.y / 2.0f);
-                                    sprite.setRotation(cell.rotation);
-                                    
-                                    // Position at the center of the occupied area
-                                    float centerX = x * TILE_SIZE + (occupiedWidth * TILE_SIZE) / 2.0f;
-                                    float centerY = y * TILE_SIZE + (occupiedHeight * TILE_SIZE) / 2.0f;
-                                    sprite.setPosition(centerX, centerY);
-                                } else {
-                                    // No rotation - position at top-left
-                                    sprite.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-                                }
-                            } else {
-                                // For single-cell assets, scale to fit tile size
-                                sf::Vector2u textureSize = texture.getSize();
-                                float scaleX = static_cast<float>(TILE_SIZE) / textureSize.x;
-                                float scaleY = static_cast<float>(TILE_SIZE) / textureSize.y;
-                                sprite.setScale(scaleX, scaleY);
-                                
-                                // Apply rotation for single-cell assets
-                                if (cell.rotation != 0.0f) {
-                                    sprite.setOrigin(textureSize.x / 2.0f, textureSize.y / 2.0f);
-                                    sprite.setRotation(cell.rotation);
-                                    sprite.setPosition(x * TILE_SIZE + TILE_SIZE / 2.0f, y * TILE_SIZE + TILE_SIZE / 2.0f);
-                                } else {
-                                    sprite.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-                                }
-                            }
-                            
-                            // Add slight transparency to non-current layers for visual feedback
-                            if (layer != m_currentLayer) {
-                                sprite.setColor(sf::Color(255, 255, 255, 180));
-                            }
-                            
-                            m_game->window().draw(sprite);
-                        } catch (...) {
-                            // If texture not found, draw a colored rectangle
-                            if (isMultiCell) {
-                                // Draw rectangle covering the entire multi-cell area
-                                sf::RectangleShape rect(sf::Vector2f(props.width * TILE_SIZE, props.height * TILE_SIZE));
-                                rect.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-                                rect.setFillColor(sf::Color::Magenta); // Indicates missing texture
-                                
-                                if (layer != m_currentLayer) {
-                                    rect.setFillColor(sf::Color(255, 0, 255, 180));
-                                }
-                                
-                                m_game->window().draw(rect);
-                            } else {
-                                // Single cell fallback
-                                sf::RectangleShape rect(sf::Vector2f(TILE_SIZE, TILE_SIZE));
-                                rect.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-                                rect.setFillColor(sf::Color::Magenta);
-                                
-                                if (layer != m_currentLayer) {
-                                    rect.setFillColor(sf::Color(255, 0, 255, 180));
-                                }
-                                
-                                m_game->window().draw(rect);
-                            }
-                        }
-                    }
-                }
+        for (const RenderChunk* chunk : m_visibleRenderChunks) {
+            for (const RenderMesh& mesh : chunk->layers[layer]) {
+                m_game->window().draw(mesh.vertices.data(), mesh.vertices.size(), sf::Triangles, sf::RenderStates(mesh.texture));
             }
         }
-        
-        // Clear drawn assets set for next layer
-        drawnAssets.clear();
     }
 }
 
@@ -1699,19 +1726,15 @@ void Scene_GridMapEditor::rotateAsset()
               << rotatedWidth << "x" << rotatedHeight << ")" << std::endl;
 }
 
-Scene_GridMapEditor::AssetProperties Scene_GridMapEditor::getAssetProperties(const std::string& assetName)
+const Scene_GridMapEditor::AssetProperties& Scene_GridMapEditor::getAssetProperties(const std::string& assetName) const
 {
     auto it = m_assetProperties.find(assetName);
     if (it != m_assetProperties.end()) {
         return it->second;
     }
     
-    // Return default properties if not found
-    AssetProperties defaultProps;
-    defaultProps.width = 1;
-    defaultProps.height = 1;
-    defaultProps.defaultCollision = false;
-    defaultProps.defaultRotation = 0.0f;
+    // Default properties if not found: 1x1, no collision, no rotation
+    static const AssetProperties defaultProps;
     return defaultProps;
 }
 
@@ -1744,6 +1767,7 @@ void Scene_GridMapEditor::clearMultiCellArea(int x, int y, int width, int height
             
             auto cellKey = std::make_pair(clearX, clearY);
             if (m_infiniteGrid.find(cellKey) != m_infiniteGrid.end()) {
+                invalidateRenderChunk(clearX, clearY);
                 m_infiniteGrid[cellKey].erase(m_currentLayer);
                 
                 // If no layers remain for this cell, remove the cell entirely
@@ -1757,28 +1781,23 @@ void Scene_GridMapEditor::clearMultiCellArea(int x, int y, int width, int height
 
 void Scene_GridMapEditor::drawCollisionOverlay()
 {
-    // Draw collision indicators for all objects with collision
+    // Queue collision indicators for all visible objects with collision on m_debugDraw
     Vec2 gridMin = getVisibleGridMin();
     Vec2 gridMax = getVisibleGridMax();
     
     for (int x = static_cast<int>(gridMin.x); x <= static_cast<int>(gridMax.x); x++) {
         for (int y = static_cast<int>(gridMin.y); y <= static_cast<int>(gridMax.y); y++) {
-            auto cellKey = std::make_pair(x, y);
-            if (m_infiniteGrid.find(cellKey) != m_infiniteGrid.end()) {
-                for (auto& layerPair : m_infiniteGrid[cellKey]) {
-                    const GridCell& cell = layerPair.second;
-                    
-                    if (cell.hasCollision && cell.occupied) {
-                        // Draw red overlay for collision
-                        sf::RectangleShape collisionOverlay;
-                        collisionOverlay.setSize(sf::Vector2f(TILE_SIZE - 2, TILE_SIZE - 2));
-                        collisionOverlay.setPosition(x * TILE_SIZE + 1, y * TILE_SIZE + 1);
-                        collisionOverlay.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
-                        collisionOverlay.setOutlineColor(sf::Color::Red);
-                        collisionOverlay.setOutlineThickness(1);
-                        
-                        m_game->window().draw(collisionOverlay);
-                    }
+            auto cellIt = m_infiniteGrid.find(std::make_pair(x, y));
+            if (cellIt == m_infiniteGrid.end()) {
+                continue;
+            }
+            for (const auto& layerPair : cellIt->second) {
+                const GridCell& cell = layerPair.second;
+                
+                if (cell.hasCollision && cell.occupied) {
+                    // Semi-transparent red with a red outline
+                    m_debugDraw.fillBox(sf::FloatRect(x * TILE_SIZE + 1, y * TILE_SIZE + 1, TILE_SIZE - 2, TILE_SIZE - 2),
+                                        sf::Color(255, 0, 0, 100), sf::Color::Red);
                 }
             }
         }
@@ -1860,41 +1879,30 @@ void Scene_GridMapEditor::drawAssetSizePreview()
             int cellX = previewX + dx;
             int cellY = previewY + dy;
             
-            sf::RectangleShape preview;
-            preview.setSize(sf::Vector2f(TILE_SIZE - 6, TILE_SIZE - 6)); // Slightly smaller for better visibility
-            preview.setPosition(cellX * TILE_SIZE + 3, cellY * TILE_SIZE + 3);
+            // Slightly smaller than the cell for better visibility
+            sf::FloatRect preview(cellX * TILE_SIZE + 3, cellY * TILE_SIZE + 3, TILE_SIZE - 6, TILE_SIZE - 6);
             
             if (canPlace) {
                 // Green preview for valid placement - more transparent since asset is underneath
-                preview.setFillColor(sf::Color(0, 255, 0, 60)); // Less opaque
-                preview.setOutlineColor(sf::Color(0, 200, 0, 255)); // Slightly darker green outline
+                m_debugDraw.fillBox(preview, sf::Color(0, 255, 0, 60), sf::Color(0, 200, 0, 255), 2);
             } else {
                 // Red preview for invalid placement - more transparent since asset is underneath
-                preview.setFillColor(sf::Color(255, 0, 0, 60)); // Less opaque
-                preview.setOutlineColor(sf::Color(200, 0, 0, 255)); // Slightly darker red outline
+                m_debugDraw.fillBox(preview, sf::Color(255, 0, 0, 60), sf::Color(200, 0, 0, 255), 2);
             }
-            
-            preview.setOutlineThickness(2);
-            m_game->window().draw(preview);
         }
     }
     
     // For larger assets (3x3 or bigger), also draw a connecting outline around the entire area
     if (width >= 3 || height >= 3) {
-        sf::RectangleShape overallOutline;
-        overallOutline.setSize(sf::Vector2f(width * TILE_SIZE - 2, height * TILE_SIZE - 2));
-        overallOutline.setPosition(previewX * TILE_SIZE + 1, previewY * TILE_SIZE + 1);
-        overallOutline.setFillColor(sf::Color::Transparent);
+        sf::FloatRect overallOutline(previewX * TILE_SIZE + 1, previewY * TILE_SIZE + 1, width * TILE_SIZE - 2, height * TILE_SIZE - 2);
         
         if (canPlace) {
-            overallOutline.setOutlineColor(sf::Color(0, 255, 0, 200)); // Green for valid
+            m_debugDraw.box(overallOutline, sf::Color(0, 255, 0, 200), 3); // Green for valid
         } else {
-            overallOutline.setOutlineColor(sf::Color(255, 0, 0, 200)); // Red for invalid
+            m_debugDraw.box(overallOutline, sf::Color(255, 0, 0, 200), 3); // Red for invalid
         }
-        
-        overallOutline.setOutlineThickness(3);
-        m_game->window().draw(overallOutline);
     }
+    m_debugDraw.flush(m_game->window());
     
     // Draw cursor indicator at the actual cursor position
     sf::CircleShape cursorIndicator(8);
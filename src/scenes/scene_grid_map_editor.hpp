@@ -1,10 +1,13 @@
 #pragma once
 #include "scene.hpp"
 #include "../vec2.hpp"
+#include "../graphics/debug_draw.hpp"
 #include <fstream>
 #include <filesystem>
+#include <array>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <algorithm>
 #include <cmath>
 
@@ -39,6 +42,7 @@ protected:
     
     // Multi-layer grid: position -> layer -> cell
     std::map<std::pair<int, int>, std::map<int, GridCell>> m_infiniteGrid;
+    std::vector<std::string> m_levelOptions;  // "Option Name Value" lines, written back on save
     
     // Asset properties loaded from configuration
     struct AssetProperties {
@@ -48,6 +52,24 @@ protected:
         float defaultRotation = 0.0f;
     };
     std::map<std::string, AssetProperties> m_assetProperties;
+    int m_maxAssetCells = 1;  // Largest asset side in cells
+    
+    // Placed objects cached as triangle meshes per chunk of RENDER_CHUNK_CELLS x
+    // RENDER_CHUNK_CELLS cells - one mesh per layer and texture, keyed by the chunk of the
+    // object's origin cell. A chunk is rebuilt only after a cell in it is edited; switching
+    // the current layer just re-tints the cached vertices.
+    static const int RENDER_CHUNK_CELLS = 16;
+    struct RenderMesh {
+        const sf::Texture* texture = nullptr;  // nullptr for missing-texture placeholders
+        std::vector<sf::Vertex> vertices;
+    };
+    struct RenderChunk {
+        bool dirty = true;
+        int tintedLayer = -1;  // m_currentLayer the vertex alpha was set for
+        std::array<std::vector<RenderMesh>, 5> layers;
+    };
+    std::unordered_map<uint64_t, RenderChunk> m_renderChunks;
+    std::vector<RenderChunk*> m_visibleRenderChunks;  // drawPlacedObjects() scratch
     
     // Current layer being edited (0-4)
     int m_currentLayer = 0;
@@ -77,6 +99,7 @@ protected:
     sf::Text m_uiText;
     sf::RectangleShape m_cursor;
     Vec2 m_cursorPos;
+    DebugDraw m_debugDraw;  // Grid lines, axes, collision and placement overlays - one draw per flush
     
     // Asset preview
     sf::RectangleShape m_previewBackground;
@@ -113,6 +136,9 @@ protected:
     void drawAssetPreview();
     void drawPlacedObjects();
     void drawCollisionOverlay();
+    void invalidateRenderChunk(int x, int y);
+    void rebuildRenderChunk(int chunkX, int chunkY, RenderChunk& chunk);
+    void tintRenderChunk(RenderChunk& chunk);
     void drawAssetSizePreview();
     void drawLevelSelector();
     void drawSaveDialog();
@@ -141,7 +167,7 @@ protected:
     void setGridCell(int x, int y, const GridCell& cell);
     bool canPlaceAsset(int x, int y, int width, int height);
     void clearMultiCellArea(int x, int y, int width, int height);
-    AssetProperties getAssetProperties(const std::string& assetName);
+    const AssetProperties& getAssetProperties(const std::string& assetName) const;
     void markUnsavedChanges();
     void markChangesSaved();
     void confirmExit();
@@ -7,10 +7,12 @@
 #include "scene_save_load.hpp"
 #include "../game_engine.hpp"
 #include "../action_types.hpp"
+#include <climits>
 #include <fstream>
 #include <sstream>
 #include <chrono>
 #include <set>
+#include <map>
 
 void Scene_PlayGrid::init(const std::string &levelPath)
 {
@@ -36,9 +38,9 @@ void Scene_PlayGrid::init(const std::string &levelPath)
     // Standard confirm control
     registerAction(sf::Keyboard::Space, ActionTypes::CONFIRM);
 
-    m_tileText.setCharacterSize(18);  // Increased from 16 to 18
-    m_tileText.setFont(m_game->getAssets().getFont("ShareTech"));
-    m_tileText.setFillColor(sf::Color::White);
+    m_gridOverlay.setCellSize({m_tileSize.x, m_tileSize.y});
+    m_gridOverlay.setFont(m_game->getAssets().getFont("ShareTech"), 18);
+    m_gridOverlay.setColor(sf::Color::White);
     
     // Initialize interaction prompt text
     m_interactionPrompt.setCharacterSize(16);
@@ -76,6 +78,20 @@ void Scene_PlayGrid::init(const std::string &levelPath)
     std::string line;
     std::set<std::string> processedAssets; // Track processed multi-cell assets to avoid duplicates
     
+    // Collision footprints are rasterized into m_collisionGrid once the level bounds are known
+    struct CollisionFootprint {
+        int x, y, width, height, layer;
+    };
+    std::vector<CollisionFootprint> collisionFootprints;
+    
+    // Flow fields need the nav grid, so FlowTo NPCs are hooked up after loading
+    struct FlowAgentSpawn {
+        Entity entity;
+        int goalX, goalY;
+    };
+    std::vector<FlowAgentSpawn> flowAgents;
+    int minCellX = 0, minCellY = 0, maxCellX = -1, maxCellY = -1;
+    
     while (std::getline(file, line))
     {
         // Skip empty lines and comments
@@ -83,6 +99,20 @@ void Scene_PlayGrid::init(const std::string &levelPath)
             continue;
         }
         
+        // Level options: Option Name Value
+        if (line.rfind("Option ", 0) == 0) {
+            std::stringstream optionStream(line.substr(7));
+            std::string option;
+            int value = 0;
+            optionStream >> option >> value;
+            if (option == "StaticLayerCache") {
+                m_useStaticLayerCache = (value != 0);
+            } else {
+                std::printf("Unknown level option '%s', ignoring\n", option.c_str());
+            }
+            continue;
+        }
+        
         std::stringstream ss(line);
         std::string layerStr;
         std::string spriteName;
@@ -157,20 +187,40 @@ void Scene_PlayGrid::init(const std::string &levelPath)
             continue;
         }
         
+        // Grow the level bounds to cover this tile's footprint
+        int footprintWidth = (rotation == 90 || rotation == 270) ? height : width;
+        int footprintHeight = (rotation == 90 || rotation == 270) ? width : height;
+        if (maxCellX < minCellX) {
+            minCellX = x;
+            minCellY = y;
+            maxCellX = x + footprintWidth - 1;
+            maxCellY = y + footprintHeight - 1;
+        } else {
+            minCellX = std::min(minCellX, x);
+            minCellY = std::min(minCellY, y);
+            maxCellX = std::max(maxCellX, x + footprintWidth - 1);
+            maxCellY = std::max(maxCellY, y + footprintHeight - 1);
+        }
+        if (collision == 1) {
+            collisionFootprints.push_back({x, y, footprintWidth, footprintHeight, layerNum});
+        }
+        
         // Create entity based on layer
         CLayer::LayerType layer = static_cast<CLayer::LayerType>(layerNum);
-        auto e = m_entityManager.addEntity("LayeredTile");
+        auto e = m_entityManager.addEntity(EntityTags::LayeredTile);
         
         // Add basic components
-        e->addComponent<CTransform>(std::make_shared<CTransform>(Vec2{x * m_tileSize.x, y * m_tileSize.y}));
+        e.addComponent<CTransform>(Vec2{x * m_tileSize.x, y * m_tileSize.y});
         
         // Create sprite component with rotation support
-        auto spriteComponent = std::make_shared<CSprite>(spriteName, m_game->getAssets().getTexture(spriteName));
+        // Level tiles draw from atlas pages when their texture was packed, so tiles with
+        // different images still share a texture (and a baked mesh)
+        auto spriteComponent = e.addComponent<CSprite>(spriteName, m_game->getAssets().getTextureRegion(spriteName));
+        sf::IntRect textureRect = spriteComponent->sprite.getTextureRect();
+        sf::Vector2u textureSize(static_cast<unsigned>(textureRect.width), static_cast<unsigned>(textureRect.height));
         
         // Apply rotation if specified - using same logic as grid map editor
         if (rotation != 0) {
-            sf::Vector2u textureSize = spriteComponent->sprite.getTexture()->getSize();
-            
             // Calculate the actual occupied area dimensions after rotation
             int occupiedWidth = width;
             int occupiedHeight = height;
@@ -200,14 +250,12 @@ void Scene_PlayGrid::init(const std::string &levelPath)
             float centerY = y * m_tileSize.y + (occupiedHeight * m_tileSize.y) / 2.0f;
             
             // Update the transform to use the center position
-            e->getComponent<CTransform>()->pos = Vec2{centerX, centerY};
+            e.getComponent<CTransform>()->pos = Vec2{centerX, centerY};
             
             std::printf("Applied rotation %ddeg to %s at (%d, %d) -> center (%.1f, %.1f)\n", 
                        rotation, spriteName.c_str(), x, y, centerX, centerY);
         } else {
             // 0deg rotation - still need proper multi-cell scaling and positioning
-            sf::Vector2u textureSize = spriteComponent->sprite.getTexture()->getSize();
-            
             if (isMultiCell) {
                 // For multi-cell assets at 0deg, use same logic as rotated assets
                 int occupiedWidth = width;
@@ -226,7 +274,7 @@ void Scene_PlayGrid::init(const std::string &levelPath)
                 float centerY = y * m_tileSize.y + (occupiedHeight * m_tileSize.y) / 2.0f;
                 
                 // Update the transform to use the center position
-                e->getComponent<CTransform>()->pos = Vec2{centerX, centerY};
+                e.getComponent<CTransform>()->pos = Vec2{centerX, centerY};
                 
                 std::printf("Applied 0deg multi-cell scaling to %s (%dx%d) at (%d, %d) -> center (%.1f, %.1f)\n", 
                            spriteName.c_str(), width, height, x, y, centerX, centerY);
@@ -241,8 +289,7 @@ void Scene_PlayGrid::init(const std::string &levelPath)
             }
         }
         
-        e->addComponent<CSprite>(spriteComponent);
-        e->addComponent<CLayer>(std::make_shared<CLayer>(layer));
+        e.addComponent<CLayer>(layer);
         
         // Add collision only if explicitly specified in the level file
         if (collision == 1) {
@@ -260,13 +307,19 @@ void Scene_PlayGrid::init(const std::string &levelPath)
                     static_cast<float>(occupiedWidth * m_tileSize.x), 
                     static_cast<float>(occupiedHeight * m_tileSize.y)
                 };
-                e->addComponent<CBoundingBox>(std::make_shared<CBoundingBox>(collisionSize));
+                e.addComponent<CBoundingBox>(collisionSize);
+                
+                // The transform sits at the center of the occupied area; the box starts at its top-left
+                Vec2 boxMin{x * m_tileSize.x, y * m_tileSize.y};
+                e.addComponent<CCollision>(true, collisionSize, boxMin - e.readComponent<CTransform>()->pos);
                 
                 std::printf("Added multi-cell collision (%dx%d tiles) to %s at (%d, %d)\n", 
                            occupiedWidth, occupiedHeight, spriteName.c_str(), x, y);
             } else {
                 // Single-cell collision
-                e->addComponent<CBoundingBox>(std::make_shared<CBoundingBox>(m_tileSize));
+                e.addComponent<CBoundingBox>(m_tileSize);
+                Vec2 boxMin{x * m_tileSize.x, y * m_tileSize.y};
+                e.addComponent<CCollision>(true, m_tileSize, boxMin - e.readComponent<CTransform>()->pos);
                 std::printf("Added single-cell collision to %s at (%d, %d)\n", spriteName.c_str(), x, y);
             }
         }
@@ -281,43 +334,58 @@ void Scene_PlayGrid::init(const std::string &levelPath)
                            x, y, m_levelSpawnPosition.x, m_levelSpawnPosition.y);
                 
                 // Add visual indicator for spawn point
-                auto animationComponent = std::make_shared<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
+                auto animationComponent = e.addComponent<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
+                animationComponent->sheetOrigin = {textureRect.left, textureRect.top};
                 animationComponent->addAnimation("spawn", "PlayerSpawn", 1, 1.0f, true, 0);
                 animationComponent->play("spawn");
-                e->addComponent<CAnimation>(animationComponent);
             }
             // Handle SavePoint
             else if (spriteName == "SavePoint") {
-                e->addComponent<CSave>(std::make_shared<CSave>("SavePoint_" + std::to_string(x) + "_" + std::to_string(y), "Save Game"));
+                e.addComponent<CSave>("SavePoint_" + std::to_string(x) + "_" + std::to_string(y), "Save Game");
                 
                 // Add animation to save point
-                auto animationComponent = std::make_shared<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
+                auto animationComponent = e.addComponent<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
+                animationComponent->sheetOrigin = {textureRect.left, textureRect.top};
                 animationComponent->addAnimation("pulse", "SavePoint", 1, 0.8f, true, 0);
                 animationComponent->play("pulse");
-                e->addComponent<CAnimation>(animationComponent);
                 
                 std::printf("Created save point at position (%d, %d)\n", x, y);
             }
             // Handle NPCs
             else if (spriteName == "Dummy") {
-                // Change entity tag to NPC for easier identification
-                e = m_entityManager.addEntity("NPC");
-                e->addComponent<CTransform>(std::make_shared<CTransform>(Vec2{x * m_tileSize.x, y * m_tileSize.y}));
-                e->addComponent<CSprite>(std::make_shared<CSprite>(spriteName, m_game->getAssets().getTexture(spriteName)));
-                e->addComponent<CLayer>(std::make_shared<CLayer>(layer));
+                // Change entity tag to NPC for easier identification; the placeholder tile
+                // would otherwise be baked as a static copy of the sprite
+                e.destroy();
+                e = m_entityManager.addEntity(EntityTags::NPC);
+                e.addComponent<CTransform>(Vec2{x * m_tileSize.x, y * m_tileSize.y});
+                e.addComponent<CSprite>(spriteName, m_game->getAssets().getTexture(spriteName));
+                e.addComponent<CLayer>(layer);
                 
                 // Add animation for NPCs
-                auto animationComponent = std::make_shared<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
+                auto animationComponent = e.addComponent<CAnimation>(Vec2{static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)});
                 animationComponent->addAnimation("idle", "Dummy", 1, 1.0f, true, 0);
                 animationComponent->play("idle");
-                e->addComponent<CAnimation>(animationComponent);
+                
+                // Optional behaviour after the position: "4 Dummy X Y WalkTo GoalX GoalY",
+                // "... FlowTo GoalX GoalY" (NPCs with the same goal share a flow field) or "... Chase"
+                int goalX = 0, goalY = 0;
+                if (scriptName == "WalkTo" && ss >> goalX >> goalY) {
+                    walkTo(e, Vec2{static_cast<float>(goalX), static_cast<float>(goalY)});
+                    std::printf("NPC at (%d, %d) walks to (%d, %d)\n", x, y, goalX, goalY);
+                } else if (scriptName == "FlowTo" && ss >> goalX >> goalY) {
+                    flowAgents.push_back({e, goalX, goalY});
+                    std::printf("NPC at (%d, %d) flows to (%d, %d)\n", x, y, goalX, goalY);
+                } else if (scriptName == "Chase") {
+                    followFlowField(e, PLAYER_FLOW_FIELD);
+                    std::printf("NPC at (%d, %d) chases the player\n", x, y);
+                }
                 
                 std::printf("Loading NPC: %s at position (%d, %d)\n", spriteName.c_str(), x, y);
             }
             // Handle Script Tiles
             else if (!scriptName.empty()) {
                 // This is a Script Tile with a script to execute
-                e->addComponent<CScriptTile>(std::make_shared<CScriptTile>(scriptName, CScriptTile::ON_ENTER, true));
+                e.addComponent<CScriptTile>(scriptName, CScriptTile::ON_ENTER, true);
                 std::printf("Created Script Tile '%s' with script '%s' at position (%d, %d)\n", 
                            spriteName.c_str(), scriptName.c_str(), x, y);
             }
@@ -333,7 +401,30 @@ void Scene_PlayGrid::init(const std::string &levelPath)
         std::printf("%s\n", logMessage.c_str());
     }
     file.close();
-    std::printf("Level loaded\n");
+    
+    m_collisionGrid.reset(minCellX, minCellY, maxCellX, maxCellY);
+    for (const auto& footprint : collisionFootprints) {
+        m_collisionGrid.blockStatic(footprint.x, footprint.y, footprint.width, footprint.height, footprint.layer);
+    }
+    m_pathfinding.reset(m_collisionGrid);
+    m_navGrid.reset(m_collisionGrid);
+    m_flowFields.assign(1, FlowField());
+    m_flowFields[PLAYER_FLOW_FIELD].reset(m_navGrid);
+    std::map<std::pair<int, int>, uint32_t> flowFieldByGoal;
+    for (const auto& spawn : flowAgents) {
+        auto goal = std::make_pair(spawn.goalX, spawn.goalY);
+        auto it = flowFieldByGoal.find(goal);
+        if (it == flowFieldByGoal.end()) {
+            Vec2 goalCell{static_cast<float>(spawn.goalX), static_cast<float>(spawn.goalY)};
+            it = flowFieldByGoal.emplace(goal, addFlowField(goalCell)).first;
+        }
+        followFlowField(spawn.entity, it->second);
+    }
+    m_entityManager.update(); // drop destroyed placeholders before baking
+    bakeStaticTiles();
+    m_staticLayerCache.clear();
+    m_staticLayerCache.setOrderLimit(m_useStaticLayerCache ? CLayer::ENTITY * 100 : 0);
+    std::printf("Level loaded%s\n", m_useStaticLayerCache ? " (static layer cache on)" : "");
     
     // Create player entity
     spawnPlayer();
@@ -350,26 +441,20 @@ void Scene_PlayGrid::onEnd()
 
 void Scene_PlayGrid::sAnimation()
 {
-    for (auto &entity : m_entityManager.getEntities())
+    for (auto [entity, animation, sprite] : m_entityManager.view<CAnimation, CSprite>())
     {
-        if (entity->hasComponent<CAnimation>() && entity->hasComponent<CSprite>())
-        {
-            auto animation = entity->getComponent<CAnimation>();
-            auto sprite = entity->getComponent<CSprite>();
-            
-            // Let the animation component handle its own logic
-            animation->update(m_deltaTime, sprite->sprite);
-        }
+        // Let the animation component handle its own logic
+        animation.update(m_deltaTime, sprite.sprite);
     }
 }
 
 void Scene_PlayGrid::sCamera()
 {
     // Update camera to follow player
-    if (m_player && m_player->hasComponent<CCamera>() && m_player->hasComponent<CTransform>())
+    if (m_player && m_player.hasComponents<CCamera, CTransform>())
     {
-        auto camera = m_player->getComponent<CCamera>();
-        auto transform = m_player->getComponent<CTransform>();
+        auto camera = m_player.getComponent<CCamera>();
+        auto transform = m_player.readComponent<CTransform>();
         
         if (camera && transform) {
             // Store previous camera position for debugging
@@ -395,98 +480,292 @@ void Scene_PlayGrid::sCamera()
 
 void Scene_PlayGrid::sCollision()
 {
-    // Skip collision handling for grid-based movement
-    // Grid movement handles collisions during movement planning
-    if (m_player && m_player->hasComponent<CGridMovement>()) {
+    // Grid-based movement is skipped here - it handles collisions during movement
+    // planning (see syncDynamicBodies()), so only freely moving bodies are resolved
+    if (m_dynamicBodies.empty()) {
         return;
     }
     
-    // Player collision with tiles (for non-grid movement)
-    if (m_player && m_player->hasComponent<CTransform>() && m_player->hasComponent<CBoundingBox>())
+    // Broadphase between moving bodies (projectiles, NPCs, enemies, free-moving player)
+    for (uint32_t id : m_dynamicBodies)
     {
-        auto playerTransform = m_player->getComponent<CTransform>();
-        auto playerBBox = m_player->getComponent<CBoundingBox>();
-        
-        // Store original position
-        Vec2 originalPos = playerTransform->pos;
+        Entity body = m_entityManager.getEntity(id);
+        m_bodyBroadphase.update(id, body.readComponent<CTransform>()->pos, body.readComponent<CBoundingBox>()->size);
+    }
+    m_bodyPairs.clear();
+    m_bodyBroadphase.findPairs(m_bodyPairs);
+    for (const auto& [a, b] : m_bodyPairs)
+    {
+        Entity first = m_entityManager.getEntity(a);
+        Entity second = m_entityManager.getEntity(b);
+        separateBodies(*first.getComponent<CTransform>(), first.readComponent<CBoundingBox>()->size,
+                       *second.getComponent<CTransform>(), second.readComponent<CBoundingBox>()->size);
+    }
+    
+    // Bodies against level collision last, so nothing is left pushed into a wall
+    for (uint32_t id : m_dynamicBodies)
+    {
+        Entity body = m_entityManager.getEntity(id);
+        auto transform = body.getComponent<CTransform>();
+        auto boundingBox = body.readComponent<CBoundingBox>();
         
-        // Check collision with all tile entities
-        auto& tileEntities = m_entityManager.getEntities("Tile");
-        for (auto &entity : tileEntities)
+        // Check collision with the collidable tiles near the body
+        m_nearbyTiles.clear();
+        m_collisionHash.query(transform->pos, boundingBox->size, [&](uint32_t tileId) {
+            m_nearbyTiles.push_back(tileId);
+            return false;
+        });
+        for (uint32_t tileId : m_nearbyTiles)
         {
-            // Safety check: ensure entity is valid and active
-            if (!entity || !entity->isActive()) {
+            Vec2 tilePos, tileSize;
+            if (!getCollisionBox(m_entityManager.getEntity(tileId), tilePos, tileSize)) {
                 continue;
             }
             
-            if (entity->hasComponent<CTransform>() && entity->hasComponent<CBoundingBox>())
+            // Check if body overlaps with tile (earlier resolutions may already have moved it clear)
+            if (isColliding(transform->pos, boundingBox->size, tilePos, tileSize))
             {
-                auto tileTransform = entity->getComponent<CTransform>();
-                auto tileBBox = entity->getComponent<CBoundingBox>();
-                
-                // Additional safety checks
-                if (!tileTransform || !tileBBox) {
-                    continue;
-                }
-                
-                // Check if player overlaps with tile
-                if (isColliding(playerTransform->pos, playerBBox->size, 
-                               tileTransform->pos, tileBBox->size))
+                // Play collision sound (when sound files are available)
+                if (body.hasComponent<CSound>())
                 {
-                    // Play collision sound (when sound files are available)
-                    if (m_player->hasComponent<CSound>())
-                    {
-                        auto sound = m_player->getComponent<CSound>();
-                        // Uncomment when you have sound files:
-                        // sound->playSound("collision");
-                    }
-                    
-                    // Calculate overlap amounts
-                    float overlapX = std::min(playerTransform->pos.x + playerBBox->size.x - tileTransform->pos.x,
-                                            tileTransform->pos.x + tileBBox->size.x - playerTransform->pos.x);
-                    float overlapY = std::min(playerTransform->pos.y + playerBBox->size.y - tileTransform->pos.y,
-                                            tileTransform->pos.y + tileBBox->size.y - playerTransform->pos.y);
-                    
-                    // Resolve collision by moving player out of tile
-                    if (overlapX < overlapY)
-                    {
-                        // Horizontal collision
-                        if (playerTransform->pos.x < tileTransform->pos.x)
-                        {
-                            playerTransform->pos.x = tileTransform->pos.x - playerBBox->size.x;
-                        }
-                        else
-                        {
-                            playerTransform->pos.x = tileTransform->pos.x + tileBBox->size.x;
-                        }
-                        playerTransform->velocity.x = 0;
-                    }
-                    else
-                    {
-                        // Vertical collision
-                        if (playerTransform->pos.y < tileTransform->pos.y)
-                        {
-                            playerTransform->pos.y = tileTransform->pos.y - playerBBox->size.y;
-                        }
-                        else
-                        {
-                            playerTransform->pos.y = tileTransform->pos.y + tileBBox->size.y;
-                        }
-                        playerTransform->velocity.y = 0;
-                    }
+                    auto sound = body.readComponent<CSound>();
+                    (void)sound;
+                    // Uncomment when you have sound files:
+                    // sound->playSound("collision");
                 }
+                
+                resolveAgainstBox(*transform, boundingBox->size, tilePos, tileSize);
+            }
+        }
+    }
+}
+
+void Scene_PlayGrid::resolveAgainstBox(CTransform& transform, const Vec2& size, const Vec2& boxPos, const Vec2& boxSize)
+{
+    // Calculate overlap amounts
+    float overlapX = std::min(transform.pos.x + size.x - boxPos.x,
+                            boxPos.x + boxSize.x - transform.pos.x);
+    float overlapY = std::min(transform.pos.y + size.y - boxPos.y,
+                            boxPos.y + boxSize.y - transform.pos.y);
+    
+    // Resolve collision by moving the body out of the box
+    if (overlapX < overlapY)
+    {
+        // Horizontal collision
+        if (transform.pos.x < boxPos.x)
+        {
+            transform.pos.x = boxPos.x - size.x;
+        }
+        else
+        {
+            transform.pos.x = boxPos.x + boxSize.x;
+        }
+        transform.velocity.x = 0;
+    }
+    else
+    {
+        // Vertical collision
+        if (transform.pos.y < boxPos.y)
+        {
+            transform.pos.y = boxPos.y - size.y;
+        }
+        else
+        {
+            transform.pos.y = boxPos.y + boxSize.y;
+        }
+        transform.velocity.y = 0;
+    }
+}
+
+void Scene_PlayGrid::separateBodies(CTransform& a, const Vec2& sizeA, CTransform& b, const Vec2& sizeB)
+{
+    // Earlier pairs may already have pushed them apart
+    if (!isColliding(a.pos, sizeA, b.pos, sizeB)) {
+        return;
+    }
+    
+    // Both bodies give way by half the overlap along the shallower axis
+    float overlapX = std::min(a.pos.x + sizeA.x - b.pos.x, b.pos.x + sizeB.x - a.pos.x);
+    float overlapY = std::min(a.pos.y + sizeA.y - b.pos.y, b.pos.y + sizeB.y - a.pos.y);
+    if (overlapX < overlapY)
+    {
+        float push = (a.pos.x < b.pos.x ? -overlapX : overlapX) / 2.0f;
+        a.pos.x += push;
+        b.pos.x -= push;
+        a.velocity.x = 0;
+        b.velocity.x = 0;
+    }
+    else
+    {
+        float push = (a.pos.y < b.pos.y ? -overlapY : overlapY) / 2.0f;
+        a.pos.y += push;
+        b.pos.y -= push;
+        a.velocity.y = 0;
+        b.velocity.y = 0;
+    }
+}
+
+void Scene_PlayGrid::syncDynamicBodies()
+{
+    // Rebuild the body list when boxes, collision flags, layers or grid movement are
+    // added/removed (level load, spawns, despawns); positions are refreshed every frame
+    uint64_t structureVersion = uint64_t(m_entityManager.getComponents<CBoundingBox>().structureVersion()) +
+                                m_entityManager.getComponents<CTransform>().structureVersion() +
+                                m_entityManager.getComponents<CCollision>().structureVersion() +
+                                m_entityManager.getComponents<CLayer>().structureVersion() +
+                                m_entityManager.getComponents<CGridMovement>().structureVersion();
+    if (structureVersion == m_bodyStructureVersion) {
+        return;
+    }
+    
+    m_dynamicBodies.clear();
+    m_bodyBroadphase.clear();
+    Vec2 min, size;
+    for (auto [entity, transform, boundingBox] : m_entityManager.view<const CTransform, const CBoundingBox>())
+    {
+        // Level collision stays in m_collisionHash; grid movers never overlap anything
+        if (getCollisionBox(entity, min, size) || entity.hasComponent<CLayer>() ||
+            entity.hasComponent<CGridMovement>()) {
+            continue;
+        }
+        m_dynamicBodies.push_back(static_cast<uint32_t>(entity.id()));
+    }
+    m_bodyStructureVersion = structureVersion;
+}
+
+void Scene_PlayGrid::sFollowPaths()
+{
+    // Only entities mid-step or with cells left to walk are touched (and marked changed)
+    for (auto [entity, path, gridMovement, transform] : m_entityManager.view<const CPath, const CGridMovement, const CTransform>())
+    {
+        if (!gridMovement.isMoving && !path.hasPath()) {
+            continue;
+        }
+        auto movement = entity.getComponent<CGridMovement>();
+        
+        if (!movement->isMoving && path.hasPath())
+        {
+            auto follow = entity.getComponent<CPath>();
+            Vec2 next = follow->waypoints[follow->nextWaypoint];
+            int deltaX = static_cast<int>(next.x - movement->gridPos.x);
+            int deltaY = static_cast<int>(next.y - movement->gridPos.y);
+            
+            if (std::abs(deltaX) + std::abs(deltaY) != 1) {
+                // Pushed off the path - ask for a new one
+                follow->setGoal(follow->goal);
+            } else if (!m_collisionGrid.isBlocked(static_cast<int>(next.x), static_cast<int>(next.y))) {
+                // Another NPC standing on the next cell just makes this one wait
+                movement->tryMove(deltaX, deltaY);
+                follow->nextWaypoint++;
             }
         }
         
-        // Keep player within window bounds
-    // Remove boundary restrictions - allow movement to negative positions
-    // The world should be infinite in all directions
-    // (Removed window boundary clamping code)
+        entity.getComponent<CTransform>()->pos = movement->updateMovement(m_deltaTime, transform.pos);
     }
 }
 
-void Scene_PlayGrid::sEnemySpawner()
+void Scene_PlayGrid::syncPaths()
+{
+    // Start and collect path requests serially; the searches themselves run on workers
+    m_pathfinding.update();
+    for (auto [entity, path, gridMovement] : m_entityManager.view<const CPath, const CGridMovement>())
+    {
+        if (path.needsPath)
+        {
+            auto follow = entity.getComponent<CPath>();
+            if (follow->requestId != 0) {
+                m_pathfinding.cancel(follow->requestId);
+            }
+            follow->requestId = m_pathfinding.request(gridMovement.gridPos, follow->goal);
+            follow->needsPath = false;
+            continue;
+        }
+        
+        PathfindingService::Result result;
+        if (path.requestId != 0 && m_pathfinding.takeResult(path.requestId, result))
+        {
+            auto follow = entity.getComponent<CPath>();
+            follow->waypoints = std::move(result.path);
+            follow->nextWaypoint = 0;
+            follow->unreachable = !result.found;
+            follow->requestId = 0;
+        }
+    }
+}
+
+void Scene_PlayGrid::sFollowFlow()
+{
+    for (auto [entity, agent, gridMovement, transform] : m_entityManager.view<const CFlowAgent, const CGridMovement, const CTransform>())
+    {
+        if (agent.field >= m_flowFields.size()) {
+            continue;
+        }
+        const FlowField& field = m_flowFields[agent.field];
+        int cellX = static_cast<int>(gridMovement.gridPos.x);
+        int cellY = static_cast<int>(gridMovement.gridPos.y);
+        
+        if (!gridMovement.isMoving)
+        {
+            // One byte per agent: the step stored in the cell it stands on
+            FlowField::Step step = field.direction(cellX, cellY);
+            bool arrived = field.distance(cellX, cellY) <= agent.stopDistance;
+            if (arrived || (step.dx == 0 && step.dy == 0) ||
+                m_collisionGrid.isBlocked(cellX + step.dx, cellY + step.dy)) {
+                continue;
+            }
+            entity.getComponent<CGridMovement>()->tryMove(step.dx, step.dy);
+        }
+        
+        auto movement = entity.getComponent<CGridMovement>();
+        entity.getComponent<CTransform>()->pos = movement->updateMovement(m_deltaTime, transform.pos);
+    }
+}
+
+void Scene_PlayGrid::syncFlowFields()
+{
+    // The player field is only maintained while someone follows it; the player steps one
+    // cell at a time, so each update is an incremental repair
+    if (m_flowFields.empty() || m_entityManager.view<const CFlowAgent>().empty()) {
+        return;
+    }
+    if (m_player && m_player.hasComponent<CGridMovement>())
+    {
+        Vec2 cell = m_player.readComponent<CGridMovement>()->gridPos;
+        m_flowFields[PLAYER_FLOW_FIELD].setGoal(static_cast<int>(cell.x), static_cast<int>(cell.y));
+    }
+}
+
+uint32_t Scene_PlayGrid::addFlowField(const Vec2& goalCell)
+{
+    m_flowFields.emplace_back();
+    m_flowFields.back().reset(m_navGrid);
+    m_flowFields.back().setGoal(static_cast<int>(goalCell.x), static_cast<int>(goalCell.y));
+    return static_cast<uint32_t>(m_flowFields.size() - 1);
+}
+
+void Scene_PlayGrid::followFlowField(Entity npc, uint32_t field)
+{
+    if (!npc.hasComponent<CGridMovement>()) {
+        auto gridMovement = npc.addComponent<CGridMovement>(m_tileSize.x, 4.0f, true);
+        gridMovement->snapToGrid(npc.readComponent<CTransform>()->pos);
+    }
+    // Flow agents and path followers would both step the same CGridMovement
+    if (npc.hasComponent<CPath>()) {
+        npc.removeComponent<CPath>();
+    }
+    npc.addComponent<CFlowAgent>(field);
+}
+void Scene_PlayGrid::walkTo(Entity npc, const Vec2& cell)
 {
+    // Grid movement is added on first use, so static NPCs don't pay for it
+    if (!npc.hasComponent<CGridMovement>()) {
+        auto gridMovement = npc.addComponent<CGridMovement>(m_tileSize.x, 4.0f, true);
+        gridMovement->snapToGrid(npc.readComponent<CTransform>()->pos);
+    }
+    if (!npc.hasComponent<CPath>()) {
+        npc.addComponent<CPath>();
+    }
+    npc.getComponent<CPath>()->setGoal(cell);
 }
 
 void Scene_PlayGrid::sMovement()
@@ -497,14 +776,14 @@ void Scene_PlayGrid::sMovement()
     }
     
     // Handle player grid movement
-    if (m_player && m_player->hasComponent<CInput>() && m_player->hasComponent<CTransform>() && m_player->hasComponent<CGridMovement>())
+    if (m_player && m_player.hasComponents<CInput, CTransform, CGridMovement>())
     {
-        auto input = m_player->getComponent<CInput>();
-        auto transform = m_player->getComponent<CTransform>();
-        auto gridMovement = m_player->getComponent<CGridMovement>();
-        auto animation = m_player->getComponent<CAnimation>();
-        auto boundingBox = m_player->getComponent<CBoundingBox>();
-        auto sound = m_player->getComponent<CSound>();  // Get sound component
+        auto input = m_player.getComponent<CInput>();
+        auto transform = m_player.getComponent<CTransform>();
+        auto gridMovement = m_player.getComponent<CGridMovement>();
+        auto animation = m_player.getComponent<CAnimation>();
+        auto boundingBox = m_player.readComponent<CBoundingBox>();
+        auto sound = m_player.getComponent<CSound>();  // Get sound component
         
         // Create collision check function
         auto collisionCheck = [this](Vec2 pos, Vec2 size) -> bool {
@@ -587,32 +866,14 @@ void Scene_PlayGrid::sMovement()
         input->resetPressFlags();
         
         // Play movement sound if moving (when sound files are available)
-        if (moved && m_player->hasComponent<CSound>())
+        if (moved && m_player.hasComponent<CSound>())
         {
-            auto sound = m_player->getComponent<CSound>();
+            auto sound = m_player.getComponent<CSound>();
+            (void)sound;
             // Uncomment when you have sound files:
             // sound->playSound("footstep");
         }
     }
-    
-    // Handle other entity movement
-    auto& allEntities = m_entityManager.getEntities();
-    for (auto &entity : allEntities)
-    {
-        // Safety check: ensure entity is valid and active
-        if (!entity || !entity->isActive()) {
-            continue;
-        }
-        
-        if (entity->hasComponent<CTransform>())
-        {
-            auto transform = entity->getComponent<CTransform>();
-            if (!transform) {
-                continue;
-            }
-            // Apply any general movement logic here
-        }
-    }
 }
 
 void Scene_PlayGrid::sRender()
@@ -625,96 +886,110 @@ void Scene_PlayGrid::sRender()
     background.setPosition(0, 0);
     m_game->window().draw(background);
     
+    // Camera's view bounds, for culling and the debug grid
+    const sf::View& gameView = m_game->getGameView();
+    sf::FloatRect viewRect(gameView.getCenter() - gameView.getSize() / 2.0f, gameView.getSize());
+    if (m_player && m_player.hasComponent<CCamera>())
+    {
+        auto bounds = m_player.readComponent<CCamera>()->getViewBounds(gameView.getSize().x, gameView.getSize().y);
+        viewRect = sf::FloatRect(bounds.left, bounds.top, bounds.right - bounds.left, bounds.bottom - bounds.top);
+    }
+    
     if(m_drawTextures){
-        // Collect all renderable entities with layer information
-        std::vector<std::shared_ptr<Entity>> renderableEntities;
-        
-        for (auto &entity : m_entityManager.getEntities())
+        // The chunk grid is a persistent render list: sprites are filed when they spawn and
+        // re-filed only when they move, change layer or get a new sprite
+        auto& sprites = m_entityManager.getComponents<CSprite>();
+        auto& transforms = m_entityManager.getComponents<CTransform>();
+        auto& layers = m_entityManager.getComponents<CLayer>();
+        uint64_t structureVersion = uint64_t(sprites.structureVersion()) + transforms.structureVersion() +
+                                    layers.structureVersion();
+        if (structureVersion != m_renderStructureVersion)
         {
-            if (entity->hasComponent<CSprite>() && entity->hasComponent<CTransform>())
-            {
-                renderableEntities.push_back(entity);
-            }
-        }
-        
-        // Sort entities by layer order (0 -> 1 -> 2 -> 3 -> 4)
-        std::sort(renderableEntities.begin(), renderableEntities.end(), 
-            [](const std::shared_ptr<Entity>& a, const std::shared_ptr<Entity>& b) {
-                // Get layer components (default to layer 0 if not present)
-                int orderA = 0;
-                int orderB = 0;
-                
-                if (a->hasComponent<CLayer>()) {
-                    orderA = a->getComponent<CLayer>()->getRenderOrder();
+            // Removals swap-and-pop component pools, so refresh every listed sprite's address
+            // and drop entities that lost their sprite or transform
+            m_spriteChunks.rebind([&](uint32_t id) -> sf::Sprite* {
+                CSprite* sprite = sprites.get(id);
+                if (!sprite || !transforms.has(id) || isStaticTile(m_entityManager.getEntity(id))) {
+                    return nullptr;
                 }
-                if (b->hasComponent<CLayer>()) {
-                    orderB = b->getComponent<CLayer>()->getRenderOrder();
-                }
-                
-                return orderA < orderB;
+                return &sprite->sprite;
             });
+            m_renderStructureVersion = structureVersion;
+        }
         
-        // Render entities in layer order
-        for (auto &entity : renderableEntities) {
-            auto sprite = entity->getComponent<CSprite>();
-            auto transform = entity->getComponent<CTransform>();
-            
+        // (Re)file sprites that spawned or whose sprite, layer or position changed;
+        // static tiles are drawn from m_staticTiles
+        auto refile = [&](size_t id) {
+            CSprite* sprite = sprites.get(id);
+            const CTransform* transform = transforms.get(id);
+            if (!sprite || !transform || isStaticTile(m_entityManager.getEntity(static_cast<uint32_t>(id)))) {
+                return;
+            }
+            // Default to layer 0 if no layer component is present
+            const CLayer* layer = layers.get(id);
+            int order = layer ? layer->getRenderOrder() : 0;
             // Use consistent top-down coordinate system (no Y-axis flip)
-            float posX = transform->pos.x;
-            float posY = transform->pos.y;
-            
-            sprite->sprite.setPosition(posX, posY);
-            m_game->window().draw(sprite->sprite);
+            sprite->sprite.setPosition(transform->pos.x, transform->pos.y);
+            m_spriteChunks.add(static_cast<uint32_t>(id), &sprite->sprite, order);
+        };
+        sprites.eachChangedSince(m_lastRenderTick, refile);
+        layers.eachChangedSince(m_lastRenderTick, refile);
+        transforms.eachChangedSince(m_lastRenderTick, refile);
+        m_lastRenderTick = m_entityManager.changeTick();
+        
+        // Cull whole chunks against the view and render visible entities in layer order -
+        // baked tiles of a layer go before the sprites on that layer, as they were loaded first
+        // With the static layer cache on, cached layers are composited first and their
+        // meshes skipped below
+        int cachedOrders = m_staticLayerCache.orderLimit();
+        if (cachedOrders > 0) {
+            m_staticLayerCache.draw(m_game->window(), m_staticTiles, viewRect);
         }
+        m_staticTiles.visibleMeshes(viewRect, m_visibleMeshes);
+        m_spriteChunks.visibleSprites(viewRect, m_visibleSprites);
+        // Sprites are batched per texture within one render order; the batch is flushed
+        // whenever the order changes and before each mesh, so layering is kept
+        size_t nextSprite = 0;
+        auto drawSpritesBefore = [&](int order) {
+            for (; nextSprite < m_visibleSprites.size() && m_visibleSprites[nextSprite].order < order; nextSprite++) {
+                if (nextSprite > 0 && m_visibleSprites[nextSprite - 1].order != m_visibleSprites[nextSprite].order) {
+                    m_spriteBatch.flush(m_game->window());
+                }
+                m_spriteBatch.draw(*m_visibleSprites[nextSprite].sprite);
+            }
+            m_spriteBatch.flush(m_game->window());
+        };
+        for (const auto& mesh : m_visibleMeshes) {
+            if (mesh.order < cachedOrders) {
+                continue;
+            }
+            drawSpritesBefore(mesh.order);
+            m_staticTiles.draw(m_game->window(), *mesh.mesh);
+        }
+        drawSpritesBefore(INT_MAX);
     }
     if (m_drawGrid)
     {
-        // Use consistent coordinate system (same as sprites)
-        for (size_t i = 0; i < 30; i++)
-        {
-            for (size_t j = 0; j < 30; j++)
-            {
-                float posX = j * m_tileSize.x;
-                float posY = i * m_tileSize.y; // Use normal Y-axis (same as sprites)
-
-                m_tileText.setPosition(posX, posY);
-                m_tileText.setString("(" + std::to_string(j) + ", " + std::to_string(i) + ")");
-                m_game->window().draw(m_tileText);
-
-                // draw the transparent square with white border for the tile
-                sf::RectangleShape rect;
-                rect.setSize({m_tileSize.x, m_tileSize.y});
-                rect.setPosition(posX, posY);
-                rect.setFillColor(sf::Color::Transparent);
-                rect.setOutlineColor(sf::Color::White);
-                rect.setOutlineThickness(1);
-                m_game->window().draw(rect);
-            }
-        }
+        // Cell outlines and coordinates over the whole view, rebuilt only when the
+        // visible cell range changes
+        m_gridOverlay.update(viewRect);
+        m_gridOverlay.draw(m_game->window());
     }
     if(m_drawCollision){
-        for (auto &entity : m_entityManager.getEntities())
+        // Every visible box goes into one vertex array and one draw call
+        for (auto [entity, boundingBox, transform] : m_entityManager.view<const CBoundingBox, const CTransform>())
         {
-            if (entity->hasComponent<CBoundingBox>() && entity->hasComponent<CTransform>())
-            {
-                auto boundingBox = entity->getComponent<CBoundingBox>();
-                auto transform = entity->getComponent<CTransform>();
-                float posX = transform->pos.x;
-                float posY = transform->pos.y; // Use normal Y-axis (same as sprites)
-                sf::RectangleShape rect;
-                rect.setSize({boundingBox->size.x, boundingBox->size.y});
-                rect.setPosition(posX, posY);
-                rect.setFillColor(sf::Color::Transparent);
-                rect.setOutlineColor(sf::Color::Red);
-                rect.setOutlineThickness(1);
-                m_game->window().draw(rect);
+            sf::FloatRect box(transform.pos.x, transform.pos.y, boundingBox.size.x, boundingBox.size.y);
+            if (box.intersects(viewRect)) {
+                m_debugDraw.box(box, sf::Color::Red);
             }
         }
+        m_debugDraw.flush(m_game->window());
     }
     
     // Draw interaction prompt if near an NPC
-    if (m_showInteractionPrompt && m_nearbyNPC && m_nearbyNPC->hasComponent<CTransform>()) {
-        auto npcTransform = m_nearbyNPC->getComponent<CTransform>();
+    if (m_showInteractionPrompt && m_nearbyNPC && m_nearbyNPC.hasComponent<CTransform>()) {
+        auto npcTransform = m_nearbyNPC.readComponent<CTransform>();
         
         // Position the prompt above the NPC
         float promptX = npcTransform->pos.x;
@@ -779,18 +1054,18 @@ void Scene_PlayGrid::sDoAction(const Action &action)
         else if (action.getName() == "INTERACT")
         {
             // Handle dialogue interaction with NPCs
-            if (m_nearbyNPC != nullptr) {
+            if (m_nearbyNPC) {
                 startDialogue(m_nearbyNPC);
             }
             // Handle save interaction with save points
-            else if (m_nearbySavePoint != nullptr) {
+            else if (m_nearbySavePoint) {
                 openSaveMenu();
             }
         }
         // Player movement input
-        else if (m_player && m_player->hasComponent<CInput>())
+        else if (m_player && m_player.hasComponent<CInput>())
         {
-            auto input = m_player->getComponent<CInput>();
+            auto input = m_player.getComponent<CInput>();
             if (action.getName() == "UP") {
                 input->up = true;
                 input->upPressed = true;
@@ -813,9 +1088,9 @@ void Scene_PlayGrid::sDoAction(const Action &action)
     {
         std::printf("End action: %s\n", action.getName().c_str());
         // Handle key release for player movement
-        if (m_player && m_player->hasComponent<CInput>())
+        if (m_player && m_player.hasComponent<CInput>())
         {
-            auto input = m_player->getComponent<CInput>();
+            auto input = m_player.getComponent<CInput>();
             if (action.getName() == "UP") input->up = false;
             else if (action.getName() == "DOWN") input->down = false;
             else if (action.getName() == "LEFT") input->left = false;
@@ -832,13 +1107,13 @@ void Scene_PlayGrid::sDebug()
     // }
 }
 
-Vec2 Scene_PlayGrid::gridToMidPixel(float gridX, float gridY, std::shared_ptr<Entity> entity)
+Vec2 Scene_PlayGrid::gridToMidPixel(float gridX, float gridY, Entity entity)
 {
-    if (entity->hasComponent<CTransform>() && entity->hasComponent<CBoundingBox>())
+    if (entity.hasComponents<CTransform, CBoundingBox>())
     {
-        Vec2 pos = entity->getComponent<CTransform>()->pos;
-        Vec2 scale = entity->getComponent<CTransform>()->scale;
-        Vec2 size = entity->getComponent<CBoundingBox>()->size;
+        Vec2 pos = entity.readComponent<CTransform>()->pos;
+        Vec2 scale = entity.readComponent<CTransform>()->scale;
+        Vec2 size = entity.readComponent<CBoundingBox>()->size;
         return Vec2{gridX * m_tileSize.x + m_tileSize.x / 2 - size.x * scale.x / 2 + pos.x, gridY * m_tileSize.y + m_tileSize.y / 2 - size.y * scale.y / 2 + pos.y};
     }
 
@@ -850,6 +1125,44 @@ Scene_PlayGrid::Scene_PlayGrid(GameEngine *game, const std::string &levelPath)
 {
     // Initialize game start time for play time tracking
     m_gameStartTime = std::chrono::steady_clock::now();
+    registerSystems();
+}
+
+void Scene_PlayGrid::registerSystems()
+{
+    // Component data each system touches - presence checks (hasComponent) don't count,
+    // they only read the entity's mask. Scene members used by a system are private to it.
+    m_systems.addSystem("Movement",
+        componentMask<CBoundingBox>(),
+        componentMask<CInput, CTransform, CGridMovement, CAnimation, CSound>(),
+        [this] { sMovement(); });
+    m_systems.addSystem("Collision",
+        componentMask<CBoundingBox, CCollision, CSound>(),
+        componentMask<CTransform>(),
+        [this] { sCollision(); });
+    m_systems.addSystem("Interaction",
+        componentMask<CTransform>(), 0,
+        [this] { sInteraction(); });
+    m_systems.addSystem("SaveSystem",
+        componentMask<CSave, CTransform>(), 0,
+        [this] { sSaveSystem(); });
+    m_systems.addSystem("PathFollow",
+        0,
+        componentMask<CPath, CGridMovement, CTransform>(),
+        [this] { sFollowPaths(); });
+    m_systems.addSystem("FlowFollow",
+        componentMask<CFlowAgent>(),
+        componentMask<CGridMovement, CTransform>(),
+        [this] { sFollowFlow(); });
+    m_systems.addSystem("Animation",
+        0,
+        componentMask<CAnimation, CSprite>(),
+        [this] { sAnimation(); });
+    // Moves the window's game view, so it stays on the main thread
+    m_systems.addSystem("Camera",
+        componentMask<CTransform>(),
+        componentMask<CCamera>(),
+        [this] { sCamera(); }, SYSTEM_MAIN_THREAD);
 }
 
 void Scene_PlayGrid::update()
@@ -860,13 +1173,13 @@ void Scene_PlayGrid::update()
     // Don't update game systems when paused, but still render
     if (!m_paused) {
         m_entityManager.update();
-        sMovement();
-        sCollision();
-        sInteraction();  // Check for NPC interactions
-        sSaveSystem();   // Check for save point interactions
-        sEnemySpawner();
-        sAnimation();
-        sCamera();  // Update camera system
+        syncCollisionHash();  // Serial, before systems query them
+        syncCollisionGrid();
+        syncDynamicBodies();
+        syncPaths();
+        syncFlowFields();
+        m_proximityIndex.sync(m_entityManager);
+        m_systems.run();  // Movement, collision, interaction, save points, path/flow following, animation, camera
     }
     
     // Always render (so we can see the pause menu)
@@ -883,7 +1196,7 @@ void Scene_PlayGrid::setCustomSpawnPosition(const Vec2& position)
 
 void Scene_PlayGrid::spawnPlayer()
 {
-    m_player = m_entityManager.addEntity("Player");
+    m_player = m_entityManager.addEntity(EntityTags::Player);
     
     // Determine spawn position priority:
     // 1. Custom spawn position (from save data) - highest priority
@@ -905,27 +1218,26 @@ void Scene_PlayGrid::spawnPlayer()
         std::cout << "Warning: No PlayerSpawn tile found in level, using hardcoded position" << std::endl;
     }
     
-    m_player->addComponent<CTransform>(std::make_shared<CTransform>(startPos));
+    m_player.addComponent<CTransform>(startPos);
     
     // Add grid movement component and initialize it properly
-    auto gridMovement = std::make_shared<CGridMovement>(m_tileSize.x, 4.0f, true);
+    auto gridMovement = m_player.addComponent<CGridMovement>(m_tileSize.x, 4.0f, true);
     
     // CRITICAL FIX: Initialize grid position based on actual spawn position
     gridMovement->snapToGrid(startPos);
     std::cout << "Initialized grid position to: " << gridMovement->gridPos.x << ", " << gridMovement->gridPos.y << std::endl;
     
-    m_player->addComponent<CGridMovement>(gridMovement);
     
     // Add sprite component with player texture
     auto& playerTexture = m_game->getAssets().getTexture("Player");
-    m_player->addComponent<CSprite>(std::make_shared<CSprite>("Player", playerTexture));
+    m_player.addComponent<CSprite>("Player", playerTexture);
     
     // Set up sprite sheet frame (64x64 pixel frames based on the sprite sheet)
-    auto sprite = m_player->getComponent<CSprite>();
+    auto sprite = m_player.getComponent<CSprite>();
     sprite->sprite.setTextureRect(sf::IntRect(0, 0, m_playerScale, m_playerScale)); // First frame
     
     // Add animation component with flexible animation definitions (using player scale)
-    auto animationComponent = std::make_shared<CAnimation>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)});
+    auto animationComponent = m_player.addComponent<CAnimation>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)});
 
     // Define animations for single-frame texture - all use the same frame
     animationComponent->addAnimation("idle", "Player", 1, 1.0f, true, 0);        // 1 frame, 1s duration, loop
@@ -935,24 +1247,22 @@ void Scene_PlayGrid::spawnPlayer()
     animationComponent->addAnimation("walk_left", "Player", 1, 0.5f, true, 0);   // 1 frame, 0.5s duration, loop
 
     animationComponent->play("idle"); // Start with idle animation
-    m_player->addComponent<CAnimation>(animationComponent);
     
     // Grid movement component is already added above with proper initialization
     
     // Add bounding box (using player scale for accurate collision)
-    m_player->addComponent<CBoundingBox>(std::make_shared<CBoundingBox>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)}));
+    m_player.addComponent<CBoundingBox>(Vec2{static_cast<float>(m_playerScale), static_cast<float>(m_playerScale)});
     
     // Add input component
-    m_player->addComponent<CInput>(std::make_shared<CInput>());
+    m_player.addComponent<CInput>();
     
     // Add camera component with 1-tile dead zone
     Vec2 deadZoneSize = {static_cast<float>(m_gameScale), static_cast<float>(m_gameScale)}; // 1 tile dead zone
-    auto cameraComponent = std::make_shared<CCamera>(startPos, deadZoneSize, 3.0f); // Follow speed of 3.0
+    auto cameraComponent = m_player.addComponent<CCamera>(startPos, deadZoneSize, 3.0f); // Follow speed of 3.0
     
     // Ensure camera starts exactly at player position
     cameraComponent->setPosition(startPos);  // This sets both position and targetPosition
     
-    m_player->addComponent<CCamera>(cameraComponent);
     
     // Initialize game view to center player in middle of screen
     sf::View& gameView = m_game->getGameView();
@@ -963,12 +1273,11 @@ void Scene_PlayGrid::spawnPlayer()
     std::printf("Camera initialized at position: %f, %f (player position)\n", startPos.x, startPos.y);
     
     // Add sound component
-    auto soundComponent = std::make_shared<CSound>();
+    auto soundComponent = m_player.addComponent<CSound>();
     // Load player-specific sounds
     soundComponent->addSound("footstep", "assets/sounds/tap.wav");
     soundComponent->addSound("hurt", "assets/sounds/hurt.wav");
     soundComponent->addSound("jump", "assets/sounds/jump.wav");
-    m_player->addComponent<CSound>(soundComponent);
     
     std::printf("Player spawned at position: %f, %f\n", startPos.x, startPos.y);
 }
@@ -986,100 +1295,170 @@ bool Scene_PlayGrid::wouldCollideAtPosition(const Vec2& position, const Vec2& si
     // Remove window boundary restrictions - allow movement to negative positions
     // The world should be infinite in all directions
     
-    // Check collision with entities that have collision (decoration layers 1-3)
-    for (auto &entity : m_entityManager.getEntities())
+    // Static level collision plus NPCs, looked up per cell - a grid move checks exactly one cell
+    return m_collisionGrid.isAreaBlocked(position, size);
+}
+
+void Scene_PlayGrid::syncCollisionGrid()
+{
+    // NPCs are moving blockers in the grid's dynamic overlay, placed by the cell under their center
+    auto placeNPC = [&](Entity npc, const CTransform& transform) {
+        m_collisionGrid.setDynamic(static_cast<uint32_t>(npc.id()),
+                                   m_collisionGrid.cellOf(transform.pos.x + m_tileSize.x / 2.0f),
+                                   m_collisionGrid.cellOf(transform.pos.y + m_tileSize.y / 2.0f));
+    };
+    
+    // Spawns and despawns re-place every NPC; otherwise only the ones that moved
+    uint32_t structureVersion = m_entityManager.getComponents<CTransform>().structureVersion();
+    if (structureVersion != m_blockerStructureVersion)
     {
-        // Safety check: ensure entity is valid and active
-        if (!entity || !entity->isActive()) {
-            continue;
-        }
-        
-        // Only check collision with entities that have layer component and collision
-        if (entity->hasComponent<CLayer>() && entity->hasComponent<CTransform>() && entity->hasComponent<CBoundingBox>())
+        m_collisionGrid.clearDynamic();
+        for (auto npc : m_entityManager.getEntities(EntityTags::NPC))
         {
-            auto layer = entity->getComponent<CLayer>();
-            auto tileTransform = entity->getComponent<CTransform>();
-            auto tileBBox = entity->getComponent<CBoundingBox>();
-            
-            // Additional safety checks
-            if (!layer || !tileTransform || !tileBBox) {
-                continue;
+            if (auto transform = npc.readComponent<CTransform>()) {
+                placeNPC(npc, *transform);
             }
-            
-            // Only check collision with tiles that have collision enabled
-            auto collision = entity->getComponent<CCollision>();
-            if (collision && collision->isCollidable())
-            {
-                if (isColliding(position, size, tileTransform->pos, tileBBox->size))
-                {
-                    return true; // Would collide with this tile
-                }
+        }
+        m_blockerStructureVersion = structureVersion;
+    }
+    else
+    {
+        m_entityManager.view<const CTransform>().eachChanged<const CTransform>(m_lastBlockerTick, [&](Entity entity, const CTransform& transform) {
+            if (entity.tagId() == EntityTags::NPC) {
+                placeNPC(entity, transform);
             }
+        });
+    }
+    m_lastBlockerTick = m_entityManager.changeTick();
+}
+
+bool Scene_PlayGrid::isStaticTile(Entity entity) const
+{
+    // Level tiles never move; animated ones (spawn/save markers) change texture rects
+    return entity.tagId() == EntityTags::LayeredTile && !entity.hasComponent<CAnimation>();
+}
+
+void Scene_PlayGrid::bakeStaticTiles()
+{
+    // Tiles are baked with their final transforms, so call this after the level is loaded
+    m_staticTiles.clear();
+    for (auto [entity, sprite, transform, layer] : m_entityManager.view<CSprite, const CTransform, const CLayer>())
+    {
+        if (!isStaticTile(entity)) {
+            continue;
         }
-        
-        // Also check collision with old-style Tile entities for backward compatibility
-        else if (entity->tag() == "Tile" && entity->hasComponent<CTransform>() && entity->hasComponent<CBoundingBox>())
+        sprite.sprite.setPosition(transform.pos.x, transform.pos.y);
+        m_staticTiles.add(sprite.sprite, layer.getRenderOrder());
+    }
+    m_staticTiles.upload();
+    std::printf("Baked %zu static tiles into %zu meshes\n", m_staticTiles.tileCount(), m_staticTiles.meshCount());
+}
+
+bool Scene_PlayGrid::getCollisionBox(Entity entity, Vec2& min, Vec2& size)
+{
+    auto transform = entity.readComponent<CTransform>();
+    auto boundingBox = entity.readComponent<CBoundingBox>();
+    if (!transform || !boundingBox) {
+        return false;
+    }
+    
+    // Layered tiles collide only when collision is enabled (decoration layers 1-3)
+    if (entity.hasComponent<CLayer>())
+    {
+        auto collision = entity.readComponent<CCollision>();
+        if (!collision || !collision->isCollidable()) {
+            return false;
+        }
+        min = transform->pos + collision->collisionOffset;
+    }
+    // Also collide with old-style Tile entities for backward compatibility
+    else if (entity.tagId() == EntityTags::Tile)
+    {
+        min = transform->pos;
+    }
+    else
+    {
+        return false;
+    }
+    
+    size = boundingBox->size;
+    return true;
+}
+
+void Scene_PlayGrid::syncCollisionHash()
+{
+    // Adding or removing boxes, collision flags or layers can change which entities collide:
+    // rebuild. That happens at level load and on spawns/despawns, not on ordinary frames.
+    uint64_t structureVersion = uint64_t(m_entityManager.getComponents<CBoundingBox>().structureVersion()) +
+                                m_entityManager.getComponents<CCollision>().structureVersion() +
+                                m_entityManager.getComponents<CLayer>().structureVersion();
+    auto boxes = m_entityManager.view<const CTransform, const CBoundingBox>();
+    Vec2 min, size;
+    
+    if (structureVersion != m_collisionStructureVersion)
+    {
+        m_collisionHash.clear();
+        for (auto [entity, transform, boundingBox] : boxes)
         {
-            auto tileTransform = entity->getComponent<CTransform>();
-            auto tileBBox = entity->getComponent<CBoundingBox>();
-            
-            if (!tileTransform || !tileBBox) {
-                continue;
-            }
-            
-            if (isColliding(position, size, tileTransform->pos, tileBBox->size))
-            {
-                return true; // Would collide with this tile
+            if (getCollisionBox(entity, min, size)) {
+                m_collisionHash.update(static_cast<uint32_t>(entity.id()), min, size);
             }
         }
+        m_collisionStructureVersion = structureVersion;
     }
-    
-    return false; // No collision detected
+    else
+    {
+        // Otherwise only re-bucket entities that moved, resized or toggled collision
+        auto refresh = [&](Entity entity) {
+            uint32_t id = static_cast<uint32_t>(entity.id());
+            if (getCollisionBox(entity, min, size)) {
+                m_collisionHash.update(id, min, size);
+            } else {
+                m_collisionHash.remove(id);
+            }
+        };
+        boxes.eachChanged<const CTransform>(m_lastCollisionTick, [&](Entity entity, const CTransform&, const CBoundingBox&) {
+            refresh(entity);
+        });
+        boxes.eachChanged<const CBoundingBox>(m_lastCollisionTick, [&](Entity entity, const CTransform&, const CBoundingBox&) {
+            refresh(entity);
+        });
+        m_entityManager.getComponents<CCollision>().eachChangedSince(m_lastCollisionTick, [&](size_t id) {
+            refresh(m_entityManager.getEntity(static_cast<uint32_t>(id)));
+        });
+    }
+    m_lastCollisionTick = m_entityManager.changeTick();
 }
 
 // Dialogue interaction system implementation
 void Scene_PlayGrid::sInteraction()
 {
-    if (!m_player || !m_player->hasComponent<CTransform>()) {
+    if (!m_player || !m_player.hasComponent<CTransform>()) {
         return;
     }
     
-    auto playerTransform = m_player->getComponent<CTransform>();
+    auto playerTransform = m_player.readComponent<CTransform>();
     Vec2 playerPos = playerTransform->pos;
     
     // Reset nearby NPC
-    m_nearbyNPC = nullptr;
+    m_nearbyNPC = Entity();
     m_showInteractionPrompt = false;
     
-    // Check all NPC entities for interaction
-    for (auto& entity : m_entityManager.getEntities("NPC")) {
-        if (!entity->hasComponent<CTransform>() || !entity->hasComponent<CSprite>()) {
-            continue;
-        }
-        
-        auto entityTransform = entity->getComponent<CTransform>();
-        auto entitySprite = entity->getComponent<CSprite>();
-        
-        Vec2 npcPos = entityTransform->pos;
-        
-        // Calculate distance between player and NPC
-        float distance = sqrt(pow(playerPos.x - npcPos.x, 2) + pow(playerPos.y - npcPos.y, 2));
-        
-        if (distance <= m_interactionRange) {
-            m_nearbyNPC = entity;
-            m_showInteractionPrompt = true;
-            break;  // Found nearby NPC, no need to check others
-        }
+    // Check the NPCs near the player for interaction
+    Entity npc = m_proximityIndex.findInRadius(playerPos, m_interactionRange, m_npcFilter);
+    if (npc) {
+        m_nearbyNPC = npc;
+        m_showInteractionPrompt = true;
     }
 }
 
-void Scene_PlayGrid::startDialogue(std::shared_ptr<Entity> npc)
+void Scene_PlayGrid::startDialogue(Entity npc)
 {
-    if (!npc || !npc->hasComponent<CSprite>()) {
+    if (!npc || !npc.hasComponent<CSprite>()) {
         return;
     }
     
-    auto npcSprite = npc->getComponent<CSprite>();
+    auto npcSprite = npc.getComponent<CSprite>();
     std::string dialogueFile = getNPCDialogueFile(npcSprite->name);
     
     if (!dialogueFile.empty()) {
@@ -1087,7 +1466,7 @@ void Scene_PlayGrid::startDialogue(std::shared_ptr<Entity> npc)
         std::cout << "Using dialogue file: " << dialogueFile << std::endl;
         
         // Preserve current game state
-        Vec2 currentPlayerPos = m_player->getComponent<CTransform>()->pos;
+        Vec2 currentPlayerPos = m_player.readComponent<CTransform>()->pos;
         int currentHealth = 100; // TODO: Get from player health component when implemented
         int currentPlayTime = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - m_gameStartTime).count());
@@ -1136,34 +1515,28 @@ void Scene_PlayGrid::sSaveSystem()
 {
     if (!m_player) return;
     
-    Vec2 playerPos = m_player->getComponent<CTransform>()->pos;
-    m_nearbySavePoint = nullptr;
+    Vec2 playerPos = m_player.readComponent<CTransform>()->pos;
+    m_nearbySavePoint = Entity();
     m_showSavePrompt = false;
     
     // Check for nearby save points
-    for (auto& entity : m_entityManager.getEntities()) {
-        if (entity->hasComponent<CSave>()) {
-            Vec2 savePos = entity->getComponent<CTransform>()->pos;
-            float distance = sqrt(pow(playerPos.x - savePos.x, 2) + pow(playerPos.y - savePos.y, 2));
+    Entity savePoint = m_proximityIndex.findInRadius(playerPos, m_interactionRange, m_savePointFilter);
+    if (savePoint) {
+        m_nearbySavePoint = savePoint;
+        m_showSavePrompt = true;
+        Vec2 savePos = savePoint.readComponent<CTransform>()->pos;
+        
+        // Setup save prompt text
+        try {
+            m_savePrompt.setFont(m_game->getAssets().getFont("ShareTech"));
+            m_savePrompt.setCharacterSize(16);
+            m_savePrompt.setFillColor(sf::Color::Yellow);
+            m_savePrompt.setString("Press E to Save Game");
             
-            if (distance <= m_interactionRange) {
-                m_nearbySavePoint = entity;
-                m_showSavePrompt = true;
-                
-                // Setup save prompt text
-                try {
-                    m_savePrompt.setFont(m_game->getAssets().getFont("ShareTech"));
-                    m_savePrompt.setCharacterSize(16);
-                    m_savePrompt.setFillColor(sf::Color::Yellow);
-                    m_savePrompt.setString("Press E to Save Game");
-                    
-                    // Position above the save point
-                    m_savePrompt.setPosition(savePos.x - 60, savePos.y - 40);
-                } catch (const std::exception& e) {
-                    std::cout << "Warning: Could not set save prompt font: " << e.what() << std::endl;
-                }
-                break;
-            }
+            // Position above the save point
+            m_savePrompt.setPosition(savePos.x - 60, savePos.y - 40);
+        } catch (const std::exception& e) {
+            std::cout << "Warning: Could not set save prompt font: " << e.what() << std::endl;
         }
     }
 }
@@ -1172,7 +1545,7 @@ void Scene_PlayGrid::openSaveMenu()
 {
     // Store current player position before opening save menu
     if (m_player) {
-        m_playerPositionBeforeSave = m_player->getComponent<CTransform>()->pos;
+        m_playerPositionBeforeSave = m_player.readComponent<CTransform>()->pos;
         std::cout << "Stored player position before save: " << m_playerPositionBeforeSave.x << ", " << m_playerPositionBeforeSave.y << std::endl;
     }
     
@@ -1190,7 +1563,7 @@ SaveData Scene_PlayGrid::getCurrentGameData()
     data.levelName = "Level 1"; // TODO: Get actual level name
     
     if (m_player) {
-        Vec2 playerPos = m_player->getComponent<CTransform>()->pos;
+        Vec2 playerPos = m_player.readComponent<CTransform>()->pos;
         data.playerX = playerPos.x;
         data.playerY = playerPos.y;
         data.playerHealth = 100; // TODO: Get actual player health
@@ -1216,7 +1589,7 @@ void Scene_PlayGrid::applyLoadedGameData(const SaveData& data)
     
     // If player already exists, update position immediately
     if (m_player) {
-        m_player->getComponent<CTransform>()->pos = Vec2(data.playerX, data.playerY);
+        m_player.getComponent<CTransform>()->pos = Vec2(data.playerX, data.playerY);
         std::cout << "Updated existing player position" << std::endl;
     }
     
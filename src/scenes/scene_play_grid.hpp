@@ -1,6 +1,19 @@
 #pragma once
 #include "../components/engine_components.hpp"
+#include "../graphics/debug_draw.hpp"
+#include "../graphics/grid_overlay.hpp"
+#include "../graphics/sprite_batch.hpp"
+#include "../graphics/sprite_chunk_grid.hpp"
+#include "../graphics/static_layer_cache.hpp"
+#include "../graphics/tile_chunk_batch.hpp"
 #include "../systems/save_system.hpp"
+#include "../systems/system_scheduler.hpp"
+#include "../systems/spatial_hash.hpp"
+#include "../systems/collision_grid.hpp"
+#include "../systems/spatial_index.hpp"
+#include "../systems/sweep_and_prune.hpp"
+#include "../systems/pathfinding.hpp"
+#include "../systems/flow_field.hpp"
 #include "../ui/command_overlay.hpp"
 #include "scene.hpp"
 
@@ -16,7 +29,7 @@ class Scene_PlayGrid : public Scene
      };
 protected:
     std::string m_levelPath;
-    std::shared_ptr<Entity> m_player;
+    Entity m_player;
     std::shared_ptr<CSound> m_soundManager;  // Global sound manager for music and global sounds
     PlayerConfig m_playerConfig;
     bool m_drawTextures = true;
@@ -31,14 +44,14 @@ protected:
     float m_gridMoveTimer = 0.0f;   // Current timer for grid movement cooldown
     
     // Dialogue interaction system
-    std::shared_ptr<Entity> m_nearbyNPC = nullptr;  // NPC the player can interact with
+    Entity m_nearbyNPC;  // NPC the player can interact with
     float m_interactionRange = 80.0f;  // Distance for NPC interaction (slightly more than one tile)
     sf::Text m_interactionPrompt;      // "Press E to talk" text
     bool m_showInteractionPrompt = false;
     
     // Save system
     SaveSystem m_saveSystem;
-    std::shared_ptr<Entity> m_nearbySavePoint = nullptr;  // Save point the player can interact with
+    Entity m_nearbySavePoint;  // Save point the player can interact with
     sf::Text m_savePrompt;             // "Press E to save" text
     bool m_showSavePrompt = false;
     std::chrono::steady_clock::time_point m_gameStartTime;
@@ -58,17 +71,71 @@ protected:
     sf::RectangleShape m_pauseBackground;
     sf::RectangleShape m_pauseBorder;
     
-    sf::Text m_tileText;
+    // Static level tiles baked at load into per-chunk, per-layer, per-texture vertex buffers
+    TileChunkBatch m_staticTiles{16.0f * m_gameScale};
+    std::vector<TileChunkBatch::VisibleMesh> m_visibleMeshes;
+    
+    // Optional per level ("Option StaticLayerCache 1" in the level file): baked tiles of
+    // layers 0-3 are pre-rendered into chunk-sized render textures and composited
+    bool m_useStaticLayerCache = false;
+    StaticLayerCache m_staticLayerCache{16.0f * m_gameScale};
+    
+    // Every other sprite, bucketed into 16x16-tile chunks for view culling - a persistent
+    // render list where sprites are filed on spawn and re-filed only when they move or
+    // change layer
+    SpriteChunkGrid m_spriteChunks{16.0f * m_gameScale};
+    std::vector<SpriteChunkGrid::VisibleSprite> m_visibleSprites;
+    SpriteBatch m_spriteBatch;
+    uint64_t m_renderStructureVersion = ~0ull;
+    uint32_t m_lastRenderTick = 0;
+
+    GridOverlay m_gridOverlay; // m_drawGrid
+    DebugDraw m_debugDraw;     // m_drawCollision boxes
     sf::Clock m_deltaClock;
     float m_deltaTime = 0.0f;
 
+    // Per-frame systems and the components each one reads/writes
+    SystemScheduler m_systems;
+
+    // Collidable boxes bucketed by grid cell for free-movement collision (sCollision) -
+    // rebuilt when collidables are added/removed, updated in place as they move
+    SpatialHash m_collisionHash{static_cast<float>(m_gameScale)};
+    uint64_t m_collisionStructureVersion = ~0ull;
+    uint32_t m_lastCollisionTick = 0;
+    
+    // Per-cell blocking for grid moves: static level collision + NPC overlay
+    CollisionGrid m_collisionGrid{static_cast<float>(m_gameScale)};
+    uint32_t m_blockerStructureVersion = ~0u;
+    uint32_t m_lastBlockerTick = 0;
+
+    // Freely moving bodies (no grid movement, not level collision) and their broadphase -
+    // used by sCollision, the list is rebuilt only when colliders are added/removed
+    std::vector<uint32_t> m_dynamicBodies;
+    SweepAndPrune m_bodyBroadphase;
+    std::vector<SweepAndPrune::Pair> m_bodyPairs;
+    std::vector<uint32_t> m_nearbyTiles; // per-body tile query scratch
+    uint64_t m_bodyStructureVersion = ~0ull;
+
+    // Paths for CPath entities, searched on worker threads over the level's static collision
+    PathfindingService m_pathfinding;
+
+    // Shared flow fields for CFlowAgent crowds; field 0 follows the player
+    static constexpr uint32_t PLAYER_FLOW_FIELD = 0;
+    NavGrid m_navGrid;
+    std::vector<FlowField> m_flowFields;
+
+    // Entity positions for proximity checks - only NPCs and save points are indexed
+    SpatialFilter m_npcFilter{EntityTags::NPC, componentMask<CTransform, CSprite>()};
+    SpatialFilter m_savePointFilter{INVALID_TAG, componentMask<CSave, CTransform>()};
+    SpatialIndex m_proximityIndex{static_cast<float>(m_gameScale), {m_npcFilter, m_savePointFilter}};
+
     void init(const std::string &levelPath);
     void init();
+    void registerSystems();
     void onEnd();
     void sAnimation();
     void sCamera();
     void sCollision();
-    void sEnemySpawner();
     void sMovement();
     void sRender();
     void sDoAction(const Action& action);
@@ -77,7 +144,7 @@ protected:
     
     // Dialogue interaction methods
     void sInteraction();  // Check for nearby NPCs and handle interaction prompts
-    void startDialogue(std::shared_ptr<Entity> npc);  // Start dialogue with an NPC
+    void startDialogue(Entity npc);  // Start dialogue with an NPC
     std::string getNPCDialogueFile(const std::string& npcName);  // Get dialogue file for NPC
     
     // Save system methods
@@ -95,11 +162,32 @@ protected:
     
     bool isColliding(const Vec2& pos1, const Vec2& size1, const Vec2& pos2, const Vec2& size2);
     bool wouldCollideAtPosition(const Vec2& position, const Vec2& size);
-    Vec2 gridToMidPixel(float gridX, float gridY, std::shared_ptr<Entity> entity);
+    bool getCollisionBox(Entity entity, Vec2& min, Vec2& size);
+    void syncCollisionHash();
+    bool isStaticTile(Entity entity) const;
+    void bakeStaticTiles();
+    void syncCollisionGrid();
+    void syncDynamicBodies();
+    void syncPaths();
+    void sFollowPaths();
+    void syncFlowFields();
+    void sFollowFlow();
+    void resolveAgainstBox(CTransform& transform, const Vec2& size, const Vec2& boxPos, const Vec2& boxSize);
+    void separateBodies(CTransform& a, const Vec2& sizeA, CTransform& b, const Vec2& sizeB);
+    Vec2 gridToMidPixel(float gridX, float gridY, Entity entity);
 public:
     Scene_PlayGrid(GameEngine* game, const std::string& levelPath);
     void update();
     
+    // Flow fields for CFlowAgent entities - agents set CFlowAgent::field to the returned index
+    uint32_t addFlowField(const Vec2& goalCell);
+    
+    // Makes an NPC follow a shared flow field (PLAYER_FLOW_FIELD chases the player)
+    void followFlowField(Entity npc, uint32_t field);
+    
+    // Sends an NPC to a grid cell along a searched path (syncPaths/PathFollow take it from there)
+    void walkTo(Entity npc, const Vec2& cell);
+    
     // Public methods for save/load system
     void applyLoadedGameData(const SaveData& data);  // Apply loaded game state
     void setCustomSpawnPosition(const Vec2& position); // Set custom spawn position from save
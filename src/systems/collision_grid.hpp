@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../vec2.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Per-level tile collision map for grid movement
+// - Static part: one byte per cell inside the level bounds, bit N set when a layer-N tile with
+//   Collision=1 covers the cell (multi-cell footprints are rasterized at load). Built once.
+// - Dynamic overlay: blocker counts per cell for things that move (NPCs), keyed by entity id
+//   so they can be moved or removed without touching the static part.
+// A grid move asks about one destination cell, which is one byte load plus one count load.
+class CollisionGrid {
+public:
+    explicit CollisionGrid(float cellSize = 64.0f) : m_cellSize(cellSize) {}
+
+    // Static map - call reset() with the level's cell bounds, then block each footprint
+    void reset(int minX, int minY, int maxX, int maxY);
+    void blockStatic(int cellX, int cellY, int width, int height, int layer);
+
+    // Dynamic overlay - place (or move) a blocker on a cell, or take it off the grid
+    void setDynamic(uint32_t id, int cellX, int cellY);
+    void removeDynamic(uint32_t id);
+    void clearDynamic();
+
+    bool isStaticBlocked(int cellX, int cellY) const
+    {
+        return inBounds(cellX, cellY) && m_static[index(cellX, cellY)] != 0;
+    }
+
+    uint8_t staticLayers(int cellX, int cellY) const
+    {
+        return inBounds(cellX, cellY) ? m_static[index(cellX, cellY)] : 0;
+    }
+
+    bool isBlocked(int cellX, int cellY) const
+    {
+        if (inBounds(cellX, cellY)) {
+            size_t i = index(cellX, cellY);
+            return m_static[i] != 0 || m_dynamic[i] != 0;
+        }
+        return !m_outside.empty() && m_outside.count(key(cellX, cellY)) != 0;
+    }
+
+    // True when any cell under the box (top-left, size) is blocked; a tile-sized,
+    // tile-aligned box is exactly one cell
+    bool isAreaBlocked(const Vec2& min, const Vec2& size) const;
+
+    int cellOf(float worldCoord) const;
+    float cellSize() const { return m_cellSize; }
+    int minX() const { return m_minX; }
+    int minY() const { return m_minY; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+private:
+    bool inBounds(int cellX, int cellY) const
+    {
+        return cellX >= m_minX && cellY >= m_minY && cellX < m_minX + m_width && cellY < m_minY + m_height;
+    }
+
+    size_t index(int cellX, int cellY) const
+    {
+        return static_cast<size_t>(cellY - m_minY) * m_width + static_cast<size_t>(cellX - m_minX);
+    }
+
+    static uint64_t key(int cellX, int cellY)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+    }
+
+    void addDynamic(int cellX, int cellY, int delta);
+
+    struct DynamicBlocker {
+        int cellX = 0;
+        int cellY = 0;
+        bool placed = false;
+    };
+
+    float m_cellSize;
+    int m_minX = 0, m_minY = 0;
+    int m_width = 0, m_height = 0;
+    std::vector<uint8_t> m_static;   // layer bits per cell
+    std::vector<uint16_t> m_dynamic; // moving blockers per cell
+    std::unordered_map<uint64_t, uint16_t> m_outside; // moving blockers outside the level bounds
+    std::vector<DynamicBlocker> m_blockers; // indexed by entity id
+};
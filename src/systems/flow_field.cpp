@@ -0,0 +1,222 @@
+#include "flow_field.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// Direction codes 1..4 index these offsets (code 0 = stay)
+static const int STEP_X[4] = {1, -1, 0, 0};
+static const int STEP_Y[4] = {0, 0, 1, -1};
+
+void FlowField::reset(const NavGrid& grid) {
+    m_grid = &grid;
+    m_valid = false;
+    m_distance.assign(grid.cellCount(), UNREACHABLE);
+    m_direction.assign(grid.cellCount(), 0);
+    m_affected.assign(grid.cellCount(), 0);
+}
+
+int64_t FlowField::neighbour(size_t cell, int dir) const {
+    int width = m_grid->width();
+    int x = static_cast<int>(cell % width) + STEP_X[dir];
+    int y = static_cast<int>(cell / width) + STEP_Y[dir];
+    if (x < 0 || y < 0 || x >= width || y >= m_grid->height()) {
+        return -1;
+    }
+    return static_cast<int64_t>(y) * width + x;
+}
+
+void FlowField::setGoal(int cellX, int cellY) {
+    if (!m_grid || m_grid->cellCount() == 0) {
+        return;
+    }
+    if (m_valid && cellX == m_goalX && cellY == m_goalY) {
+        m_lastUpdateCost = 0;
+        return;
+    }
+
+    bool adjacent = std::abs(cellX - m_goalX) + std::abs(cellY - m_goalY) == 1;
+    if (m_valid && adjacent && m_grid->isWalkable(cellX, cellY) && m_grid->isWalkable(m_goalX, m_goalY)) {
+        moveGoalByOne(cellX, cellY);
+    } else {
+        m_goalX = cellX;
+        m_goalY = cellY;
+        rebuild();
+    }
+    m_valid = true;
+}
+
+void FlowField::rebuild() {
+    std::fill(m_distance.begin(), m_distance.end(), UNREACHABLE);
+    m_queue.clear();
+    if (m_grid->isWalkable(m_goalX, m_goalY)) {
+        uint32_t goal = static_cast<uint32_t>(m_grid->index(m_goalX, m_goalY));
+        m_distance[goal] = 0;
+        m_queue.push_back(goal);
+    }
+
+    // Breadth-first wave - with unit costs this is Dijkstra without a heap
+    for (size_t head = 0; head < m_queue.size(); head++) {
+        uint32_t cell = m_queue[head];
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0 && m_grid->isWalkableAt(next) && m_distance[next] == UNREACHABLE) {
+                m_distance[next] = m_distance[cell] + 1;
+                m_queue.push_back(static_cast<uint32_t>(next));
+            }
+        }
+    }
+
+    for (size_t cell = 0; cell < m_distance.size(); cell++) {
+        refreshDirection(cell);
+    }
+    m_lastUpdateCost = m_distance.size();
+}
+
+void FlowField::moveGoalByOne(int cellX, int cellY) {
+    uint32_t oldGoal = static_cast<uint32_t>(m_grid->index(m_goalX, m_goalY));
+    uint32_t newGoal = static_cast<uint32_t>(m_grid->index(cellX, cellY));
+    m_goalX = cellX;
+    m_goalY = cellY;
+    m_touched.clear();
+
+    // 1. Add the new goal as a source: lower every cell that is now closer
+    m_distance[newGoal] = 0;
+    m_touched.push_back(newGoal);
+    m_queue.clear();
+    m_queue.push_back(newGoal);
+    for (size_t head = 0; head < m_queue.size(); head++) {
+        uint32_t cell = m_queue[head];
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0 && m_grid->isWalkableAt(next) && m_distance[cell] + 1 < m_distance[next]) {
+                m_distance[next] = m_distance[cell] + 1;
+                m_queue.push_back(static_cast<uint32_t>(next));
+                m_touched.push_back(static_cast<uint32_t>(next));
+            }
+        }
+    }
+
+    // 2. Drop the old goal as a source. Cells are affected when every neighbour one step
+    //    closer is affected too; levels are visited in distance order, so a cell's
+    //    supporters are classified before it is
+    m_affectedCells.clear();
+    m_affectedCells.push_back(oldGoal);
+    m_affected[oldGoal] = 1;
+    for (size_t head = 0; head < m_affectedCells.size(); head++) {
+        uint32_t cell = m_affectedCells[head];
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next < 0 || !m_grid->isWalkableAt(next) || m_affected[next] ||
+                m_distance[next] != m_distance[cell] + 1) {
+                continue;
+            }
+            bool supported = false;
+            for (int back = 0; back < 4 && !supported; back++) {
+                int64_t support = neighbour(static_cast<size_t>(next), back);
+                supported = support >= 0 && !m_affected[support] && m_grid->isWalkableAt(support) &&
+                            m_distance[support] == m_distance[next] - 1;
+            }
+            if (!supported) {
+                m_affected[next] = 1;
+                m_affectedCells.push_back(static_cast<uint32_t>(next));
+            }
+        }
+    }
+
+    // 3. Re-derive affected cells from their unaffected neighbours, then spread
+    //    among them in distance order (sorted seeds merged with a FIFO wave)
+    m_seeds.clear();
+    for (uint32_t cell : m_affectedCells) {
+        int32_t best = UNREACHABLE;
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0 && !m_affected[next] && m_grid->isWalkableAt(next) && m_distance[next] != UNREACHABLE) {
+                best = std::min(best, m_distance[next] + 1);
+            }
+        }
+        m_distance[cell] = best;
+        if (best != UNREACHABLE) {
+            m_seeds.push_back({best, cell});
+        }
+    }
+    std::sort(m_seeds.begin(), m_seeds.end());
+
+    m_queue.clear();
+    size_t seed = 0;
+    size_t head = 0;
+    while (seed < m_seeds.size() || head < m_queue.size()) {
+        uint32_t cell;
+        int32_t dist;
+        if (head < m_queue.size() && (seed == m_seeds.size() || m_distance[m_queue[head]] <= m_seeds[seed].first)) {
+            cell = m_queue[head++];
+            dist = m_distance[cell];
+        } else {
+            cell = m_seeds[seed].second;
+            dist = m_seeds[seed++].first;
+            if (dist > m_distance[cell]) {
+                continue; // Already reached more cheaply through the wave
+            }
+        }
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0 && m_affected[next] && dist + 1 < m_distance[next]) {
+                m_distance[next] = dist + 1;
+                m_queue.push_back(static_cast<uint32_t>(next));
+            }
+        }
+    }
+
+    for (uint32_t cell : m_affectedCells) {
+        m_affected[cell] = 0;
+        m_touched.push_back(cell);
+    }
+    refreshDirections(m_touched);
+    m_lastUpdateCost = m_touched.size();
+}
+
+void FlowField::refreshDirection(size_t cell) {
+    int32_t best = m_distance[cell];
+    uint8_t code = 0;
+    if (best != UNREACHABLE && best != 0) {
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0 && m_distance[next] < best) {
+                best = m_distance[next];
+                code = static_cast<uint8_t>(dir + 1);
+            }
+        }
+    }
+    m_direction[cell] = code;
+}
+
+void FlowField::refreshDirections(const std::vector<uint32_t>& cells) {
+    // A cell's direction depends on its neighbours' distances, so refresh those too
+    for (uint32_t cell : cells) {
+        refreshDirection(cell);
+        for (int dir = 0; dir < 4; dir++) {
+            int64_t next = neighbour(cell, dir);
+            if (next >= 0) {
+                refreshDirection(static_cast<size_t>(next));
+            }
+        }
+    }
+}
+
+FlowField::Step FlowField::direction(int cellX, int cellY) const {
+    Step step;
+    if (!m_valid || !m_grid->inBounds(cellX, cellY)) {
+        return step;
+    }
+    uint8_t code = m_direction[m_grid->index(cellX, cellY)];
+    if (code != 0) {
+        step.dx = STEP_X[code - 1];
+        step.dy = STEP_Y[code - 1];
+    }
+    return step;
+}
+
+int32_t FlowField::distance(int cellX, int cellY) const {
+    if (!m_valid || !m_grid->inBounds(cellX, cellY)) {
+        return UNREACHABLE;
+    }
+    return m_distance[m_grid->index(cellX, cellY)];
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "nav_grid.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Shared navigation toward one goal cell for any number of grid agents
+// An integration field holds every cell's walking distance to the goal (4-connected,
+// unit cost), and a direction field stores the step each cell should take, so an
+// agent steers by reading one byte for the cell it stands on.
+// - Moving the goal to a neighbouring cell repairs the field incrementally: a wave from
+//   the new goal lowers the cells that got closer, then the cells that only reached the
+//   old goal are re-derived from their unaffected neighbours. Untouched cells cost nothing.
+// - Any other goal change or a walkability change recomputes the field from scratch.
+// Not thread-safe while updating; reading from parallel systems between updates is fine.
+class FlowField {
+public:
+    static constexpr int32_t UNREACHABLE = INT32_MAX;
+
+    struct Step {
+        int dx = 0;
+        int dy = 0;
+    };
+
+    // Binds the field to a grid (which must outlive it); the goal is set separately
+    void reset(const NavGrid& grid);
+    void setGoal(int cellX, int cellY);
+    void invalidate() { m_valid = false; } // The grid's walkability changed
+
+    bool hasGoal() const { return m_valid; }
+    int goalX() const { return m_goalX; }
+    int goalY() const { return m_goalY; }
+
+    // Step toward the goal from a cell; zero at the goal and where it can't be reached
+    Step direction(int cellX, int cellY) const;
+    int32_t distance(int cellX, int cellY) const;
+
+    // Cells whose distance was rewritten by the last setGoal() (for profiling/tests)
+    size_t lastUpdateCost() const { return m_lastUpdateCost; }
+
+private:
+    void rebuild();
+    void moveGoalByOne(int cellX, int cellY);
+    void refreshDirection(size_t cell);
+    void refreshDirections(const std::vector<uint32_t>& cells);
+
+    // Neighbour of a cell index in one of the 4 directions, or -1 outside the grid
+    int64_t neighbour(size_t cell, int dir) const;
+
+    const NavGrid* m_grid = nullptr;
+    int m_goalX = 0, m_goalY = 0;
+    bool m_valid = false;
+    size_t m_lastUpdateCost = 0;
+
+    std::vector<int32_t> m_distance; // integration field, per cell
+    std::vector<uint8_t> m_direction; // 0 = stay, 1..4 = E, W, S, N
+
+    // Repair scratch
+    std::vector<uint32_t> m_queue;
+    std::vector<uint32_t> m_touched;
+    std::vector<uint8_t> m_affected;
+    std::vector<uint32_t> m_affectedCells;
+    std::vector<std::pair<int32_t, uint32_t>> m_seeds;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "collision_grid.hpp"
+#include <cstdint>
+#include <vector>
+
+// Walkability snapshot of a level for navigation (pathfinding, flow fields)
+// Cells are grid coordinates like CGridMovement::gridPos; everything outside the
+// level bounds is unwalkable so searches stay finite. Moving blockers (NPCs) are
+// deliberately left out - agents wait for them instead of routing around them.
+class NavGrid {
+public:
+    // Copies the static part of a level's collision grid
+    void reset(const CollisionGrid& collision)
+    {
+        m_minX = collision.minX();
+        m_minY = collision.minY();
+        m_width = collision.width();
+        m_height = collision.height();
+        m_walkable.assign(static_cast<size_t>(m_width) * m_height, 1);
+        for (int y = 0; y < m_height; y++) {
+            for (int x = 0; x < m_width; x++) {
+                if (collision.isStaticBlocked(m_minX + x, m_minY + y)) {
+                    m_walkable[static_cast<size_t>(y) * m_width + x] = 0;
+                }
+            }
+        }
+    }
+
+    void setWalkable(int cellX, int cellY, bool walkable)
+    {
+        if (inBounds(cellX, cellY)) {
+            m_walkable[index(cellX, cellY)] = walkable ? 1 : 0;
+        }
+    }
+
+    bool isWalkable(int cellX, int cellY) const
+    {
+        return inBounds(cellX, cellY) && m_walkable[index(cellX, cellY)] != 0;
+    }
+
+    // Same as isWalkable() for a cell given by its dense index
+    bool isWalkableAt(size_t index) const { return m_walkable[index] != 0; }
+
+    bool inBounds(int cellX, int cellY) const
+    {
+        return cellX >= m_minX && cellY >= m_minY && cellX < m_minX + m_width && cellY < m_minY + m_height;
+    }
+
+    // Dense index of an in-bounds cell, row-major from (minX, minY)
+    size_t index(int cellX, int cellY) const
+    {
+        return static_cast<size_t>(cellY - m_minY) * m_width + static_cast<size_t>(cellX - m_minX);
+    }
+
+    int minX() const { return m_minX; }
+    int minY() const { return m_minY; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    size_t cellCount() const { return m_walkable.size(); }
+
+private:
+    int m_minX = 0, m_minY = 0;
+    int m_width = 0, m_height = 0;
+    std::vector<uint8_t> m_walkable;
+};
@@ -0,0 +1,566 @@
+#include "pathfinding.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+// Per-thread search buffers, reused across queries so a search allocates nothing
+// once warmed up; abstract-node entries are stamped instead of cleared
+struct HierarchicalPathfinder::Scratch {
+    std::vector<int> cellCost;
+    std::vector<uint32_t> cellParent;
+    std::vector<int> nodeCost;
+    std::vector<uint32_t> nodeParent;
+    std::vector<uint32_t> nodeStamp;
+    uint32_t stamp = 0;
+    std::vector<int> startDist;
+    std::vector<int> goalDist;
+    std::vector<uint32_t> queue;
+    std::vector<std::pair<int, uint32_t>> open; // min-heap of (estimated total, id)
+};
+
+static int rectWidth(int x0, int x1) { return x1 - x0 + 1; }
+
+void HierarchicalPathfinder::reset(const NavGrid& grid) {
+    m_grid = grid;
+    m_clustersX = (grid.width() + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (grid.height() + m_clusterSize - 1) / m_clusterSize;
+    size_t clusterCount = static_cast<size_t>(m_clustersX) * m_clustersY;
+
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_clusterNodes.assign(clusterCount, {});
+    m_borderNodes.assign(clusterCount * 2, {});
+    m_isDirty.assign(clusterCount, 1);
+    m_dirtyClusters.clear();
+    for (uint32_t c = 0; c < clusterCount; c++) {
+        m_dirtyClusters.push_back(c);
+    }
+    rebuildDirty();
+}
+
+void HierarchicalPathfinder::setWalkable(int cellX, int cellY, bool walkable) {
+    if (!m_grid.inBounds(cellX, cellY) || m_grid.isWalkable(cellX, cellY) == walkable) {
+        return;
+    }
+    m_grid.setWalkable(cellX, cellY, walkable);
+    uint32_t cluster = clusterOf(cellX, cellY);
+    if (!m_isDirty[cluster]) {
+        m_isDirty[cluster] = 1;
+        m_dirtyClusters.push_back(cluster);
+    }
+}
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::clusterRect(uint32_t cluster) const {
+    int cx = static_cast<int>(cluster) % m_clustersX;
+    int cy = static_cast<int>(cluster) / m_clustersX;
+    Rect rect;
+    rect.x0 = m_grid.minX() + cx * m_clusterSize;
+    rect.y0 = m_grid.minY() + cy * m_clusterSize;
+    rect.x1 = std::min(rect.x0 + m_clusterSize, m_grid.minX() + m_grid.width()) - 1;
+    rect.y1 = std::min(rect.y0 + m_clusterSize, m_grid.minY() + m_grid.height()) - 1;
+    return rect;
+}
+
+void HierarchicalPathfinder::rebuildDirty() {
+    // A dirty cluster invalidates its four borders, and the entrance links of every
+    // cluster whose entrances sit on those borders
+    size_t clusterCount = m_clusterNodes.size();
+    std::vector<uint8_t> borderQueued(clusterCount * 2, 0);
+    std::vector<uint8_t> linksQueued(clusterCount, 0);
+    std::vector<uint32_t> borders;
+    std::vector<uint32_t> links;
+    auto queueBorder = [&](uint32_t border) {
+        if (!borderQueued[border]) {
+            borderQueued[border] = 1;
+            borders.push_back(border);
+        }
+    };
+    auto queueLinks = [&](uint32_t cluster) {
+        if (!linksQueued[cluster]) {
+            linksQueued[cluster] = 1;
+            links.push_back(cluster);
+        }
+    };
+
+    for (uint32_t c : m_dirtyClusters) {
+        int cx = static_cast<int>(c) % m_clustersX;
+        int cy = static_cast<int>(c) / m_clustersX;
+        queueBorder(c * 2);
+        queueBorder(c * 2 + 1);
+        queueLinks(c);
+        if (cx > 0) {
+            queueBorder((c - 1) * 2);
+            queueLinks(c - 1);
+        }
+        if (cy > 0) {
+            queueBorder((c - m_clustersX) * 2 + 1);
+            queueLinks(c - m_clustersX);
+        }
+        if (cx + 1 < m_clustersX) {
+            queueLinks(c + 1);
+        }
+        if (cy + 1 < m_clustersY) {
+            queueLinks(c + m_clustersX);
+        }
+        m_isDirty[c] = 0;
+    }
+    m_dirtyClusters.clear();
+
+    for (uint32_t border : borders) {
+        rebuildBorder(border);
+    }
+    for (uint32_t cluster : links) {
+        rebuildEntranceLinks(cluster);
+    }
+}
+
+uint32_t HierarchicalPathfinder::addNode(int x, int y, uint32_t border) {
+    uint32_t id;
+    if (!m_freeNodes.empty()) {
+        id = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    } else {
+        id = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[id];
+    node.x = x;
+    node.y = y;
+    node.cluster = clusterOf(x, y);
+    node.border = border;
+    node.partner = NO_NODE;
+    node.intra.clear();
+    node.live = true;
+    m_clusterNodes[node.cluster].push_back(id);
+    m_borderNodes[border].push_back(id);
+    return id;
+}
+
+void HierarchicalPathfinder::rebuildBorder(uint32_t border) {
+    for (uint32_t id : m_borderNodes[border]) {
+        Node& node = m_nodes[id];
+        auto& clusterNodes = m_clusterNodes[node.cluster];
+        auto it = std::find(clusterNodes.begin(), clusterNodes.end(), id);
+        *it = clusterNodes.back();
+        clusterNodes.pop_back();
+        node.live = false;
+        node.intra.clear();
+        m_freeNodes.push_back(id);
+    }
+    m_borderNodes[border].clear();
+
+    uint32_t cluster = border / 2;
+    bool east = (border % 2) == 0;
+    int cx = static_cast<int>(cluster) % m_clustersX;
+    int cy = static_cast<int>(cluster) / m_clustersX;
+    if ((east && cx + 1 >= m_clustersX) || (!east && cy + 1 >= m_clustersY)) {
+        return;
+    }
+
+    // Walk along the border; each run of cells open on both sides is one entrance,
+    // long runs get one at each end so paths don't detour to the middle
+    Rect rect = clusterRect(cluster);
+    int first = east ? rect.y0 : rect.x0;
+    int last = east ? rect.y1 : rect.x1;
+    auto isOpen = [&](int i) {
+        return east ? (m_grid.isWalkable(rect.x1, i) && m_grid.isWalkable(rect.x1 + 1, i))
+                    : (m_grid.isWalkable(i, rect.y1) && m_grid.isWalkable(i, rect.y1 + 1));
+    };
+    auto addEntrance = [&](int i) {
+        uint32_t inside = east ? addNode(rect.x1, i, border) : addNode(i, rect.y1, border);
+        uint32_t across = east ? addNode(rect.x1 + 1, i, border) : addNode(i, rect.y1 + 1, border);
+        m_nodes[inside].partner = across;
+        m_nodes[across].partner = inside;
+    };
+
+    for (int i = first; i <= last; i++) {
+        if (!isOpen(i)) {
+            continue;
+        }
+        int runStart = i;
+        while (i + 1 <= last && isOpen(i + 1)) {
+            i++;
+        }
+        if (i - runStart + 1 >= 6) {
+            addEntrance(runStart);
+            addEntrance(i);
+        } else {
+            addEntrance((runStart + i) / 2);
+        }
+    }
+}
+
+void HierarchicalPathfinder::rebuildEntranceLinks(uint32_t cluster) {
+    Rect rect = clusterRect(cluster);
+    int width = rectWidth(rect.x0, rect.x1);
+    const auto& ids = m_clusterNodes[cluster];
+    for (uint32_t id : ids) {
+        Node& node = m_nodes[id];
+        node.intra.clear();
+        distancesInRect(node.x, node.y, rect, m_rebuildDist, m_rebuildQueue);
+        for (uint32_t other : ids) {
+            if (other == id) {
+                continue;
+            }
+            const Node& target = m_nodes[other];
+            int dist = m_rebuildDist[(target.y - rect.y0) * width + (target.x - rect.x0)];
+            if (dist >= 0) {
+                node.intra.push_back({other, dist});
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::distancesInRect(int x, int y, const Rect& rect, std::vector<int>& dist,
+                                             std::vector<uint32_t>& queue) const {
+    int width = rectWidth(rect.x0, rect.x1);
+    int height = rectWidth(rect.y0, rect.y1);
+    dist.assign(static_cast<size_t>(width) * height, -1);
+    queue.clear();
+
+    uint32_t start = static_cast<uint32_t>((y - rect.y0) * width + (x - rect.x0));
+    dist[start] = 0;
+    queue.push_back(start);
+    static const int dx[4] = {1, -1, 0, 0};
+    static const int dy[4] = {0, 0, 1, -1};
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t cell = queue[head];
+        int cellX = rect.x0 + static_cast<int>(cell) % width;
+        int cellY = rect.y0 + static_cast<int>(cell) / width;
+        for (int d = 0; d < 4; d++) {
+            int nx = cellX + dx[d];
+            int ny = cellY + dy[d];
+            if (!rect.contains(nx, ny) || !m_grid.isWalkable(nx, ny)) {
+                continue;
+            }
+            uint32_t next = static_cast<uint32_t>((ny - rect.y0) * width + (nx - rect.x0));
+            if (dist[next] < 0) {
+                dist[next] = dist[cell] + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+bool HierarchicalPathfinder::searchRect(int startX, int startY, int goalX, int goalY, const Rect& rect,
+                                        GridPath& out, Scratch& scratch) const {
+    int width = rectWidth(rect.x0, rect.x1);
+    int height = rectWidth(rect.y0, rect.y1);
+    scratch.cellCost.assign(static_cast<size_t>(width) * height, INT_MAX);
+    scratch.cellParent.assign(scratch.cellCost.size(), NO_NODE);
+    scratch.open.clear();
+
+    auto heuristic = [&](int x, int y) { return std::abs(x - goalX) + std::abs(y - goalY); };
+    auto local = [&](int x, int y) { return static_cast<uint32_t>((y - rect.y0) * width + (x - rect.x0)); };
+    auto later = std::greater<std::pair<int, uint32_t>>();
+
+    uint32_t start = local(startX, startY);
+    uint32_t goal = local(goalX, goalY);
+    scratch.cellCost[start] = 0;
+    scratch.open.push_back({heuristic(startX, startY), start});
+
+    static const int dx[4] = {1, -1, 0, 0};
+    static const int dy[4] = {0, 0, 1, -1};
+    while (!scratch.open.empty()) {
+        std::pop_heap(scratch.open.begin(), scratch.open.end(), later);
+        auto [estimate, cell] = scratch.open.back();
+        scratch.open.pop_back();
+        int cellX = rect.x0 + static_cast<int>(cell) % width;
+        int cellY = rect.y0 + static_cast<int>(cell) / width;
+        int cost = scratch.cellCost[cell];
+        if (estimate > cost + heuristic(cellX, cellY)) {
+            continue; // Stale entry, the cell was reached more cheaply since
+        }
+        if (cell == goal) {
+            break;
+        }
+        for (int d = 0; d < 4; d++) {
+            int nx = cellX + dx[d];
+            int ny = cellY + dy[d];
+            if (!rect.contains(nx, ny) || !m_grid.isWalkable(nx, ny)) {
+                continue;
+            }
+            uint32_t next = local(nx, ny);
+            if (cost + 1 < scratch.cellCost[next]) {
+                scratch.cellCost[next] = cost + 1;
+                scratch.cellParent[next] = cell;
+                scratch.open.push_back({cost + 1 + heuristic(nx, ny), next});
+                std::push_heap(scratch.open.begin(), scratch.open.end(), later);
+            }
+        }
+    }
+    if (scratch.cellCost[goal] == INT_MAX) {
+        return false;
+    }
+
+    size_t firstNew = out.size();
+    for (uint32_t cell = goal; cell != start; cell = scratch.cellParent[cell]) {
+        out.push_back(Vec2(static_cast<float>(rect.x0 + static_cast<int>(cell) % width),
+                           static_cast<float>(rect.y0 + static_cast<int>(cell) / width)));
+    }
+    std::reverse(out.begin() + firstNew, out.end());
+    return true;
+}
+
+bool HierarchicalPathfinder::findPath(int startX, int startY, int goalX, int goalY, GridPath& out) const {
+    out.clear();
+    if (!m_grid.isWalkable(startX, startY) || !m_grid.isWalkable(goalX, goalY)) {
+        return false;
+    }
+    if (startX == goalX && startY == goalY) {
+        return true;
+    }
+
+    thread_local Scratch scratch;
+    uint32_t startCluster = clusterOf(startX, startY);
+    uint32_t goalCluster = clusterOf(goalX, goalY);
+    Rect startRect = clusterRect(startCluster);
+    Rect goalRect = clusterRect(goalCluster);
+
+    // Same cluster: a local search usually settles it without the abstract graph
+    if (startCluster == goalCluster) {
+        if (searchRect(startX, startY, goalX, goalY, startRect, out, scratch)) {
+            return true;
+        }
+        out.clear();
+    }
+
+    // Abstract search - the start and goal join the graph through the entrances
+    // their own cluster can reach
+    distancesInRect(startX, startY, startRect, scratch.startDist, scratch.queue);
+    distancesInRect(goalX, goalY, goalRect, scratch.goalDist, scratch.queue);
+
+    const uint32_t startId = static_cast<uint32_t>(m_nodes.size());
+    const uint32_t goalId = startId + 1;
+    scratch.nodeCost.resize(m_nodes.size() + 2);
+    scratch.nodeParent.resize(m_nodes.size() + 2);
+    scratch.nodeStamp.resize(m_nodes.size() + 2, 0);
+    if (++scratch.stamp == 0) {
+        std::fill(scratch.nodeStamp.begin(), scratch.nodeStamp.end(), 0);
+        scratch.stamp = 1;
+    }
+    scratch.open.clear();
+
+    auto costOf = [&](uint32_t id) {
+        return scratch.nodeStamp[id] == scratch.stamp ? scratch.nodeCost[id] : INT_MAX;
+    };
+    auto heuristic = [&](uint32_t id) {
+        if (id == goalId) {
+            return 0;
+        }
+        int x = id == startId ? startX : m_nodes[id].x;
+        int y = id == startId ? startY : m_nodes[id].y;
+        return std::abs(x - goalX) + std::abs(y - goalY);
+    };
+    auto later = std::greater<std::pair<int, uint32_t>>();
+    auto relax = [&](uint32_t id, int cost, uint32_t parent) {
+        if (cost < costOf(id)) {
+            scratch.nodeStamp[id] = scratch.stamp;
+            scratch.nodeCost[id] = cost;
+            scratch.nodeParent[id] = parent;
+            scratch.open.push_back({cost + heuristic(id), id});
+            std::push_heap(scratch.open.begin(), scratch.open.end(), later);
+        }
+    };
+    auto distIn = [](const std::vector<int>& dist, const Rect& rect, int x, int y) {
+        return dist[(y - rect.y0) * rectWidth(rect.x0, rect.x1) + (x - rect.x0)];
+    };
+
+    relax(startId, 0, NO_NODE);
+    while (!scratch.open.empty()) {
+        std::pop_heap(scratch.open.begin(), scratch.open.end(), later);
+        auto [estimate, id] = scratch.open.back();
+        scratch.open.pop_back();
+        int cost = costOf(id);
+        if (estimate > cost + heuristic(id)) {
+            continue;
+        }
+        if (id == goalId) {
+            break;
+        }
+
+        if (id == startId) {
+            for (uint32_t entrance : m_clusterNodes[startCluster]) {
+                int dist = distIn(scratch.startDist, startRect, m_nodes[entrance].x, m_nodes[entrance].y);
+                if (dist >= 0) {
+                    relax(entrance, dist, id);
+                }
+            }
+            continue;
+        }
+
+        const Node& node = m_nodes[id];
+        if (node.partner != NO_NODE) {
+            relax(node.partner, cost + 1, id);
+        }
+        for (const Edge& edge : node.intra) {
+            relax(edge.to, cost + edge.cost, id);
+        }
+        if (node.cluster == goalCluster) {
+            int dist = distIn(scratch.goalDist, goalRect, node.x, node.y);
+            if (dist >= 0) {
+                relax(goalId, cost + dist, id);
+            }
+        }
+    }
+    if (costOf(goalId) == INT_MAX) {
+        return false;
+    }
+
+    // Refine: entrance hops are single steps across a border, every other hop stays
+    // inside one cluster and is filled in with a local search
+    std::vector<uint32_t> hops;
+    for (uint32_t id = scratch.nodeParent[goalId]; id != startId; id = scratch.nodeParent[id]) {
+        hops.push_back(id);
+    }
+    std::reverse(hops.begin(), hops.end());
+
+    int x = startX;
+    int y = startY;
+    auto stepTo = [&](int nextX, int nextY) {
+        if (nextX == x && nextY == y) {
+            return true;
+        }
+        if (std::abs(nextX - x) + std::abs(nextY - y) == 1) {
+            out.push_back(Vec2(static_cast<float>(nextX), static_cast<float>(nextY)));
+        } else if (!searchRect(x, y, nextX, nextY, clusterRect(clusterOf(x, y)), out, scratch)) {
+            return false;
+        }
+        x = nextX;
+        y = nextY;
+        return true;
+    };
+    for (uint32_t id : hops) {
+        if (!stepTo(m_nodes[id].x, m_nodes[id].y)) {
+            out.clear();
+            return false;
+        }
+    }
+    if (!stepTo(goalX, goalY)) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+PathfindingService::~PathfindingService() {
+    waitForBatch();
+}
+
+void PathfindingService::waitForBatch() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchDone.wait(lock, [this] { return m_tasksRunning == 0; });
+}
+
+void PathfindingService::reset(const CollisionGrid& collision) {
+    waitForBatch();
+
+    NavGrid grid;
+    grid.reset(collision);
+    m_pathfinder.reset(grid);
+
+    m_queued.clear();
+    m_pendingChanges.clear();
+    m_finished.clear();
+    m_cancelled.clear();
+    m_batch.clear();
+    m_batchResults.clear();
+}
+
+void PathfindingService::setWalkable(int cellX, int cellY, bool walkable) {
+    m_pendingChanges.push_back({cellX, cellY, walkable});
+}
+
+PathfindingService::RequestId PathfindingService::request(const Vec2& fromCell, const Vec2& toCell) {
+    RequestId id = m_nextId++;
+    if (m_nextId == 0) {
+        m_nextId = 1; // 0 stays free for "no request"
+    }
+    m_queued.push_back({id,
+                        static_cast<int>(std::lround(fromCell.x)), static_cast<int>(std::lround(fromCell.y)),
+                        static_cast<int>(std::lround(toCell.x)), static_cast<int>(std::lround(toCell.y))});
+    return id;
+}
+
+void PathfindingService::cancel(RequestId id) {
+    if (m_finished.erase(id)) {
+        return;
+    }
+    auto queued = std::find_if(m_queued.begin(), m_queued.end(), [id](const Query& q) { return q.id == id; });
+    if (queued != m_queued.end()) {
+        m_queued.erase(queued);
+        return;
+    }
+    m_cancelled.insert(id); // Still in the running batch - dropped when it lands
+}
+
+void PathfindingService::update() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasksRunning > 0) {
+            return; // Previous batch still running; new requests wait for the next frame
+        }
+    }
+
+    // Hand over the finished batch
+    for (size_t i = 0; i < m_batch.size(); i++) {
+        if (m_cancelled.erase(m_batch[i].id)) {
+            continue;
+        }
+        m_finished[m_batch[i].id] = std::move(m_batchResults[i]);
+    }
+    m_batch.clear();
+    m_batchResults.clear();
+
+    // No worker is reading the graph now, so cell changes can land
+    for (const CellChange& change : m_pendingChanges) {
+        m_pathfinder.setWalkable(change.x, change.y, change.walkable);
+    }
+    m_pendingChanges.clear();
+    if (m_pathfinder.hasDirty()) {
+        m_pathfinder.rebuildDirty();
+    }
+
+    if (m_queued.empty()) {
+        return;
+    }
+
+    m_batch.swap(m_queued);
+    m_batchResults.resize(m_batch.size());
+    size_t taskCount = std::max<size_t>(1, std::min(m_pool.size(), m_batch.size() / MIN_QUERIES_PER_TASK));
+    size_t perTask = (m_batch.size() + taskCount - 1) / taskCount;
+    taskCount = (m_batch.size() + perTask - 1) / perTask;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasksRunning = taskCount;
+    }
+
+    for (size_t begin = 0; begin < m_batch.size(); begin += perTask) {
+        size_t end = std::min(m_batch.size(), begin + perTask);
+        m_pool.submit([this, begin, end] {
+            for (size_t i = begin; i < end; i++) {
+                const Query& query = m_batch[i];
+                Result& result = m_batchResults[i];
+                result.found = m_pathfinder.findPath(query.fromX, query.fromY, query.toX, query.toY, result.path);
+            }
+            // Notify while holding the lock so the service can't be destroyed in between
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_tasksRunning == 0) {
+                m_batchDone.notify_all();
+            }
+        });
+    }
+}
+
+bool PathfindingService::takeResult(RequestId id, Result& result) {
+    auto it = m_finished.find(id);
+    if (it == m_finished.end()) {
+        return false;
+    }
+    result = std::move(it->second);
+    m_finished.erase(it);
+    return true;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "nav_grid.hpp"
+#include "worker_pool.hpp"
+#include "../vec2.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Cells to step through in grid coordinates (like CGridMovement::gridPos),
+// excluding the start cell and ending on the goal
+typedef std::vector<Vec2> GridPath;
+
+// HPA* (hierarchical A*) over a NavGrid
+// The grid is cut into square clusters. Walkable runs along each shared cluster border
+// become entrance nodes, and entrances inside one cluster are linked by their in-cluster
+// walking distance. A query searches this small abstract graph, then refines each hop
+// with A* confined to a single cluster, so cost grows with path length in clusters
+// rather than with map area.
+// Changing a cell only dirties its cluster; rebuildDirty() redoes that cluster's four
+// borders and the entrance links of it and its neighbours.
+class HierarchicalPathfinder {
+public:
+    explicit HierarchicalPathfinder(int clusterSize = 16) : m_clusterSize(clusterSize) {}
+
+    void reset(const NavGrid& grid);
+    void setWalkable(int cellX, int cellY, bool walkable);
+    bool hasDirty() const { return !m_dirtyClusters.empty(); }
+
+    // Brings dirty clusters up to date - call with no findPath() running
+    void rebuildDirty();
+
+    // Safe to call from several threads at once between rebuilds
+    bool findPath(int startX, int startY, int goalX, int goalY, GridPath& out) const;
+
+    const NavGrid& grid() const { return m_grid; }
+    size_t nodeCount() const { return m_nodes.size() - m_freeNodes.size(); }
+
+private:
+    static constexpr uint32_t NO_NODE = 0xFFFFFFFFu;
+
+    struct Edge {
+        uint32_t to;
+        int cost;
+    };
+
+    // Entrance cell on one side of a cluster border; partner is the cell across it
+    struct Node {
+        int x = 0, y = 0;
+        uint32_t cluster = 0;
+        uint32_t border = 0;
+        uint32_t partner = NO_NODE;
+        std::vector<Edge> intra; // other entrances of the same cluster
+        bool live = false;
+    };
+
+    // Cell rectangle of a cluster, inclusive
+    struct Rect {
+        int x0, y0, x1, y1;
+        bool contains(int x, int y) const { return x >= x0 && y >= y0 && x <= x1 && y <= y1; }
+    };
+
+    struct Scratch;
+
+    uint32_t clusterOf(int cellX, int cellY) const
+    {
+        return static_cast<uint32_t>(((cellY - m_grid.minY()) / m_clusterSize) * m_clustersX +
+                                     (cellX - m_grid.minX()) / m_clusterSize);
+    }
+    Rect clusterRect(uint32_t cluster) const;
+
+    // Borders: 2 * cluster is the east border, 2 * cluster + 1 the south border
+    void rebuildBorder(uint32_t border);
+    void rebuildEntranceLinks(uint32_t cluster);
+    uint32_t addNode(int x, int y, uint32_t border);
+
+    // Walking distances from (x, y) to every cell of rect, -1 where unreachable
+    void distancesInRect(int x, int y, const Rect& rect, std::vector<int>& dist, std::vector<uint32_t>& queue) const;
+
+    // A* between two cells without leaving rect; appends the cells after start to out
+    bool searchRect(int startX, int startY, int goalX, int goalY, const Rect& rect, GridPath& out, Scratch& scratch) const;
+
+    NavGrid m_grid;
+    int m_clusterSize;
+    int m_clustersX = 0, m_clustersY = 0;
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_freeNodes;
+    std::vector<std::vector<uint32_t>> m_clusterNodes; // entrances per cluster
+    std::vector<std::vector<uint32_t>> m_borderNodes;  // entrances per border (both sides)
+    std::vector<uint32_t> m_dirtyClusters;
+    std::vector<uint8_t> m_isDirty;
+
+    // Rebuild scratch (main thread only)
+    std::vector<int> m_rebuildDist;
+    std::vector<uint32_t> m_rebuildQueue;
+};
+
+// Batched path queries over a level, answered on worker threads
+// - request() queues a query and returns its id; update() (once per frame, main thread)
+//   hands finished results over and starts the next batch, spread across the pool
+// - Cell changes made while a batch is running are applied before the next one, so
+//   workers only ever read a graph nobody is writing
+// - Searches run on WorkerPool::background(), not the pool SystemScheduler uses, so a
+//   large batch never delays the frame's systems
+// Nothing here waits for the workers except reset() and the destructor.
+class PathfindingService {
+public:
+    typedef uint32_t RequestId;
+
+    struct Result {
+        bool found = false;
+        GridPath path;
+    };
+
+    explicit PathfindingService(WorkerPool& pool = WorkerPool::background(), int clusterSize = 16)
+        : m_pool(pool), m_pathfinder(clusterSize) {}
+    ~PathfindingService();
+
+    PathfindingService(const PathfindingService&) = delete;
+    PathfindingService& operator=(const PathfindingService&) = delete;
+
+    // New level: snapshot its static collision and drop every request
+    void reset(const CollisionGrid& collision);
+    void setWalkable(int cellX, int cellY, bool walkable);
+
+    RequestId request(const Vec2& fromCell, const Vec2& toCell);
+    void cancel(RequestId id);
+    void update();
+
+    // Moves a finished result out; false while the request is still queued or running
+    bool takeResult(RequestId id, Result& result);
+
+private:
+    struct Query {
+        RequestId id;
+        int fromX, fromY, toX, toY;
+    };
+
+    struct CellChange {
+        int x, y;
+        bool walkable;
+    };
+
+    void waitForBatch();
+
+    // Queries per worker task - small batches aren't worth spreading
+    static constexpr size_t MIN_QUERIES_PER_TASK = 4;
+
+    WorkerPool& m_pool;
+    HierarchicalPathfinder m_pathfinder;
+    RequestId m_nextId = 1;
+
+    std::vector<Query> m_queued;
+    std::vector<CellChange> m_pendingChanges;
+    std::unordered_map<RequestId, Result> m_finished;
+    std::unordered_set<RequestId> m_cancelled;
+
+    // In-flight batch - workers write m_batchResults[i] for their slice only
+    std::vector<Query> m_batch;
+    std::vector<Result> m_batchResults;
+    size_t m_tasksRunning = 0; // guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_batchDone;
+};
@@ -0,0 +1,66 @@
+#include "spatial_hash.hpp"
+#include <algorithm>
+
+void SpatialHash::update(uint32_t id, const Vec2& min, const Vec2& size) {
+    if (id >= m_items.size()) {
+        m_items.resize(id + 1);
+    }
+
+    Item& item = m_items[id];
+    CellRange range = cellRange(min, size);
+    if (!item.live) {
+        link(id, range);
+        item.live = true;
+        m_count++;
+    } else if (!(range == item.cells)) {
+        unlink(id, item.cells);
+        link(id, range);
+    }
+    item.min = min;
+    item.size = size;
+    item.cells = range;
+}
+
+void SpatialHash::remove(uint32_t id) {
+    if (!contains(id)) {
+        return;
+    }
+    unlink(id, m_items[id].cells);
+    m_items[id].live = false;
+    m_count--;
+}
+
+void SpatialHash::clear() {
+    m_cells.clear();
+    m_items.clear();
+    m_count = 0;
+}
+
+void SpatialHash::link(uint32_t id, const CellRange& range) {
+    for (int cy = range.y0; cy <= range.y1; cy++) {
+        for (int cx = range.x0; cx <= range.x1; cx++) {
+            m_cells[cellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialHash::unlink(uint32_t id, const CellRange& range) {
+    for (int cy = range.y0; cy <= range.y1; cy++) {
+        for (int cx = range.x0; cx <= range.x1; cx++) {
+            auto cell = m_cells.find(cellKey(cx, cy));
+            if (cell == m_cells.end()) {
+                continue;
+            }
+            // Cells hold a handful of ids, so a linear find + swap-pop is cheapest
+            auto& ids = cell->second;
+            auto it = std::find(ids.begin(), ids.end(), id);
+            if (it != ids.end()) {
+                *it = ids.back();
+                ids.pop_back();
+            }
+            if (ids.empty()) {
+                m_cells.erase(cell);
+            }
+        }
+    }
+}
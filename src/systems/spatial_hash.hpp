@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../vec2.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform-grid spatial hash over axis-aligned boxes, keyed by entity id
+// Each item is listed in every cell its box overlaps, so a query only visits the cells
+// under the query box - cost depends on local density, not on the size of the map.
+// Boxes are (top-left, size), matching Scene_PlayGrid::isColliding().
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 64.0f) : m_cellSize(cellSize) {}
+
+    // Insert, or move an existing item; re-buckets only when its cell range changes
+    void update(uint32_t id, const Vec2& min, const Vec2& size);
+    void remove(uint32_t id);
+    void clear();
+
+    bool contains(uint32_t id) const { return id < m_items.size() && m_items[id].live; }
+    size_t size() const { return m_count; }
+    float cellSize() const { return m_cellSize; }
+
+    // Calls fn(id) once for every item whose box overlaps (min, size)
+    // fn returns true to stop early; query() then returns true as well
+    template<typename Fn>
+    bool query(const Vec2& min, const Vec2& size, Fn&& fn) const
+    {
+        return visit(cellRange(min, size), [&](uint32_t id, const Item& item) {
+            return overlaps(min, size, item.min, item.size) && fn(id);
+        });
+    }
+
+    // Calls fn(id) once for every item whose box comes within radius of center
+    // (distance to the box's closest point, inclusive); same early-out as query()
+    template<typename Fn>
+    bool queryRadius(const Vec2& center, float radius, Fn&& fn) const
+    {
+        Vec2 min(center.x - radius, center.y - radius);
+        Vec2 size(radius * 2.0f, radius * 2.0f);
+        float radiusSq = radius * radius;
+        return visit(cellRange(min, size), [&](uint32_t id, const Item& item) {
+            float dx = std::clamp(center.x, item.min.x, item.min.x + item.size.x) - center.x;
+            float dy = std::clamp(center.y, item.min.y, item.min.y + item.size.y) - center.y;
+            return dx * dx + dy * dy <= radiusSq && fn(id);
+        });
+    }
+
+private:
+    struct CellRange {
+        int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+        bool operator==(const CellRange& o) const { return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1; }
+    };
+
+    struct Item {
+        Vec2 min;
+        Vec2 size;
+        CellRange cells;
+        bool live = false;
+    };
+
+    static uint64_t cellKey(int cx, int cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    // Boxes are half-open; a zero-size box is a point, so position-only items can be
+    // indexed and found by a box that starts exactly on them
+    static bool overlapsAxis(float a, float sizeA, float b, float sizeB)
+    {
+        if (sizeA <= 0.0f) {
+            return sizeB <= 0.0f ? a == b : (a >= b && a < b + sizeB);
+        }
+        if (sizeB <= 0.0f) {
+            return b >= a && b < a + sizeA;
+        }
+        return a < b + sizeB && a + sizeA > b;
+    }
+
+    static bool overlaps(const Vec2& minA, const Vec2& sizeA, const Vec2& minB, const Vec2& sizeB)
+    {
+        return overlapsAxis(minA.x, sizeA.x, minB.x, sizeB.x) && overlapsAxis(minA.y, sizeA.y, minB.y, sizeB.y);
+    }
+
+    // Calls test(id, item) once per item listed in the range; stops when it returns true
+    template<typename Test>
+    bool visit(const CellRange& range, Test&& test) const
+    {
+        for (int cy = range.y0; cy <= range.y1; cy++) {
+            for (int cx = range.x0; cx <= range.x1; cx++) {
+                auto cell = m_cells.find(cellKey(cx, cy));
+                if (cell == m_cells.end()) {
+                    continue;
+                }
+                for (uint32_t id : cell->second) {
+                    const Item& item = m_items[id];
+                    // An item spanning several cells is reported only from the first cell
+                    // both ranges share, so no visited-set is needed (queries stay const)
+                    if (cx != std::max(item.cells.x0, range.x0) || cy != std::max(item.cells.y0, range.y0)) {
+                        continue;
+                    }
+                    if (test(id, item)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Cells touched by a box; the far edge is exclusive so a 64px tile stays in one cell
+    CellRange cellRange(const Vec2& min, const Vec2& size) const
+    {
+        CellRange range;
+        range.x0 = static_cast<int>(std::floor(min.x / m_cellSize));
+        range.y0 = static_cast<int>(std::floor(min.y / m_cellSize));
+        range.x1 = std::max(range.x0, static_cast<int>(std::ceil((min.x + size.x) / m_cellSize)) - 1);
+        range.y1 = std::max(range.y0, static_cast<int>(std::ceil((min.y + size.y) / m_cellSize)) - 1);
+        return range;
+    }
+
+    void link(uint32_t id, const CellRange& range);
+    void unlink(uint32_t id, const CellRange& range);
+
+    float m_cellSize;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    std::vector<Item> m_items; // indexed by entity id
+    size_t m_count = 0;
+};
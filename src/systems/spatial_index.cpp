@@ -0,0 +1,69 @@
+#include "spatial_index.hpp"
+#include "../components/engine_components.hpp"
+#include <algorithm>
+
+void SpatialIndex::sync(EntityManager& entityManager) {
+    auto transforms = entityManager.view<const CTransform>();
+    const ComponentPool<CTransform>& pool = entityManager.getComponents<CTransform>();
+
+    if (m_manager != &entityManager) {
+        // A different manager: index everything it holds once
+        m_manager = &entityManager;
+        m_hash.clear();
+        m_ids.clear();
+        for (auto [entity, transform] : transforms) {
+            place(static_cast<uint32_t>(entity.id()), transform.pos);
+        }
+    } else {
+        // Despawns: drop indexed entities whose transform is gone (or no longer qualify)
+        uint32_t structureVersion = pool.structureVersion();
+        if (structureVersion != m_structureVersion) {
+            for (size_t i = 0; i < m_ids.size();) {
+                if (!pool.has(m_ids[i]) || !isIndexed(m_ids[i])) {
+                    m_hash.remove(m_ids[i]);
+                    m_ids[i] = m_ids.back();
+                    m_ids.pop_back();
+                } else {
+                    i++;
+                }
+            }
+        }
+        // Adding a component stamps it, so spawns come through here along with movers
+        transforms.eachChanged<const CTransform>(m_lastTick, [&](Entity entity, const CTransform& transform) {
+            place(static_cast<uint32_t>(entity.id()), transform.pos);
+        });
+    }
+    m_structureVersion = pool.structureVersion();
+    m_lastTick = entityManager.changeTick();
+}
+
+void SpatialIndex::place(uint32_t id, const Vec2& pos) {
+    if (!isIndexed(id)) {
+        if (m_hash.contains(id)) {
+            m_hash.remove(id);
+            m_ids.erase(std::find(m_ids.begin(), m_ids.end(), id));
+        }
+        return;
+    }
+    if (!m_hash.contains(id)) {
+        m_ids.push_back(id);
+    }
+    m_hash.update(id, pos, Vec2(0, 0));
+}
+
+void SpatialIndex::clear() {
+    m_hash.clear();
+    m_ids.clear();
+    m_manager = nullptr;
+    m_structureVersion = ~0u;
+    m_lastTick = 0;
+}
+
+Entity SpatialIndex::findInRadius(const Vec2& center, float radius, const SpatialFilter& filter) const {
+    Entity found;
+    queryRadius(center, radius, filter, [&](Entity entity) {
+        found = entity;
+        return true;
+    });
+    return found;
+}
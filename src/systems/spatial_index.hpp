@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../entity_manager.hpp"
+#include "spatial_hash.hpp"
+#include <vector>
+
+// Which entities a SpatialIndex query reports
+// tag = INVALID_TAG accepts any tag; required lists components the entity must own
+struct SpatialFilter {
+    TagId tag = INVALID_TAG;
+    ComponentMask required = 0;
+};
+
+// Entity positions (CTransform::pos) bucketed by grid cell, shared by the proximity
+// systems so "what is near X" costs time proportional to what is actually nearby
+// - Only entities accepted by one of the indexed filters are stored (all of them when the
+//   list is empty), so static level tiles don't fill the buckets; queries should use one
+//   of those filters or a narrower one. Membership is checked when a transform is added
+//   or changes, so give entities their tag and components before their first sync
+// - sync() once per frame, after EntityManager::update() and before systems run; spawns
+//   and movers arrive through the CTransform change log, and when transforms were removed
+//   only the indexed entities are checked
+// - Queries are const and may run from parallel systems between syncs
+// - Filters check the entity's tag and component mask, so they never touch component data
+class SpatialIndex {
+public:
+    explicit SpatialIndex(float cellSize = 64.0f, std::vector<SpatialFilter> indexed = {})
+        : m_hash(cellSize), m_indexed(std::move(indexed)) {}
+
+    void sync(EntityManager& entityManager);
+    void clear();
+
+    // Calls fn(Entity) for every matching entity within radius of center (inclusive)
+    // fn returns true to stop early; the query then returns true as well
+    template<typename Fn>
+    bool queryRadius(const Vec2& center, float radius, const SpatialFilter& filter, Fn&& fn) const
+    {
+        return m_hash.queryRadius(center, radius, [&](uint32_t id) {
+            return matches(id, filter) && fn(m_manager->getEntity(id));
+        });
+    }
+
+    // Calls fn(Entity) for every matching entity positioned inside the box (top-left, size)
+    template<typename Fn>
+    bool queryBox(const Vec2& min, const Vec2& size, const SpatialFilter& filter, Fn&& fn) const
+    {
+        return m_hash.query(min, size, [&](uint32_t id) {
+            return matches(id, filter) && fn(m_manager->getEntity(id));
+        });
+    }
+
+    // First matching entity within radius, or an invalid handle
+    Entity findInRadius(const Vec2& center, float radius, const SpatialFilter& filter) const;
+
+    size_t size() const { return m_hash.size(); }
+
+private:
+    bool matches(uint32_t id, const SpatialFilter& filter) const
+    {
+        const EntitySlot& slot = m_manager->getSlot(id);
+        return slot.active && (filter.tag == INVALID_TAG || slot.tag == filter.tag) &&
+               (slot.mask & filter.required) == filter.required;
+    }
+
+    bool isIndexed(uint32_t id) const
+    {
+        if (m_indexed.empty()) {
+            return true;
+        }
+        for (const SpatialFilter& filter : m_indexed) {
+            if (matches(id, filter)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void place(uint32_t id, const Vec2& pos);
+
+    SpatialHash m_hash;
+    std::vector<SpatialFilter> m_indexed;
+    std::vector<uint32_t> m_ids; // entities in m_hash, checked when transforms are removed
+    EntityManager* m_manager = nullptr;
+    uint32_t m_structureVersion = ~0u;
+    uint32_t m_lastTick = 0;
+};
@@ -0,0 +1,69 @@
+#include "sweep_and_prune.hpp"
+#include <algorithm>
+
+void SweepAndPrune::update(uint32_t id, const Vec2& min, const Vec2& size) {
+    if (id >= m_bodies.size()) {
+        m_bodies.resize(id + 1);
+    }
+
+    Body& body = m_bodies[id];
+    if (!body.live) {
+        // New bodies go to the end; the next findPairs() sorts them into place
+        m_axis.push_back(id);
+        body.live = true;
+    }
+    body.min = min;
+    body.max = min + size;
+}
+
+void SweepAndPrune::remove(uint32_t id) {
+    if (!contains(id)) {
+        return;
+    }
+    // Order-preserving erase keeps the axis list nearly sorted
+    m_axis.erase(std::find(m_axis.begin(), m_axis.end(), id));
+    m_bodies[id].live = false;
+}
+
+void SweepAndPrune::clear() {
+    m_bodies.clear();
+    m_axis.clear();
+    m_active.clear();
+}
+
+void SweepAndPrune::findPairs(std::vector<Pair>& out) {
+    // Insertion sort - bodies only move a little between frames, so few swaps are needed
+    for (size_t i = 1; i < m_axis.size(); i++) {
+        uint32_t id = m_axis[i];
+        float minX = m_bodies[id].min.x;
+        size_t j = i;
+        while (j > 0 && m_bodies[m_axis[j - 1]].min.x > minX) {
+            m_axis[j] = m_axis[j - 1];
+            j--;
+        }
+        m_axis[j] = id;
+    }
+
+    m_active.clear();
+    for (uint32_t id : m_axis) {
+        const Body& body = m_bodies[id];
+
+        // Drop bodies that end before this one starts; nothing later can reach them either
+        for (size_t i = 0; i < m_active.size();) {
+            if (m_bodies[m_active[i]].max.x <= body.min.x) {
+                m_active[i] = m_active.back();
+                m_active.pop_back();
+            } else {
+                i++;
+            }
+        }
+
+        for (uint32_t other : m_active) {
+            const Body& o = m_bodies[other];
+            if (body.min.y < o.max.y && body.max.y > o.min.y) {
+                out.emplace_back(other, id);
+            }
+        }
+        m_active.push_back(id);
+    }
+}
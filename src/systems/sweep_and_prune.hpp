@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../vec2.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Sort-and-sweep broadphase on the x axis for moving bodies, keyed by entity id
+// The axis list persists between frames and is re-sorted with an insertion sort, which
+// is close to linear while bodies move a little each frame. The sweep keeps an active
+// list of bodies whose x extent is still open and only tests those on y, so cost grows
+// with the number of overlaps along x instead of with every pair of bodies.
+// Boxes are (top-left, size) with exclusive edges, matching Scene_PlayGrid::isColliding().
+class SweepAndPrune {
+public:
+    typedef std::pair<uint32_t, uint32_t> Pair;
+
+    // Insert, or move an existing body
+    void update(uint32_t id, const Vec2& min, const Vec2& size);
+    void remove(uint32_t id);
+    void clear();
+
+    bool contains(uint32_t id) const { return id < m_bodies.size() && m_bodies[id].live; }
+    size_t size() const { return m_axis.size(); }
+
+    // Re-sorts the axis list and appends every overlapping pair of bodies to out
+    void findPairs(std::vector<Pair>& out);
+
+private:
+    struct Body {
+        Vec2 min;
+        Vec2 max;
+        bool live = false;
+    };
+
+    std::vector<Body> m_bodies; // indexed by entity id
+    std::vector<uint32_t> m_axis;   // live ids ordered by min.x
+    std::vector<uint32_t> m_active; // sweep scratch, kept to avoid reallocating
+};
@@ -0,0 +1,129 @@
+#include "system_scheduler.hpp"
+
+SystemScheduler::SystemScheduler(WorkerPool& pool) : m_pool(pool) {}
+
+void SystemScheduler::addSystem(const std::string& name, ComponentMask reads, ComponentMask writes,
+                                std::function<void()> run, unsigned int flags) {
+    Job job;
+    job.name = name;
+    job.reads = reads;
+    job.writes = writes;
+    job.flags = flags;
+    job.run = std::move(run);
+    m_jobs.push_back(std::move(job));
+    m_graphDirty = true;
+}
+
+bool SystemScheduler::conflicts(const Job& a, const Job& b) {
+    if ((a.flags & SYSTEM_EXCLUSIVE) || (b.flags & SYSTEM_EXCLUSIVE)) {
+        return true;
+    }
+    return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+}
+
+void SystemScheduler::buildGraph() {
+    // Every conflicting pair gets an edge from the earlier system to the later one,
+    // so conflicting systems keep the order they were registered in
+    for (auto& job : m_jobs) {
+        job.dependents.clear();
+        job.dependencyCount = 0;
+    }
+    for (size_t i = 0; i < m_jobs.size(); i++) {
+        for (size_t j = i + 1; j < m_jobs.size(); j++) {
+            if (conflicts(m_jobs[i], m_jobs[j])) {
+                m_jobs[i].dependents.push_back(j);
+                m_jobs[j].dependencyCount++;
+            }
+        }
+    }
+    m_remaining.resize(m_jobs.size());
+    m_graphDirty = false;
+}
+
+void SystemScheduler::run() {
+    if (m_graphDirty) {
+        buildGraph();
+    }
+
+    if (!m_warmedUp || !m_parallel) {
+        for (auto& job : m_jobs) {
+            job.run();
+        }
+        m_warmedUp = true;
+        return;
+    }
+
+    std::vector<size_t> roots;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = m_jobs.size();
+        m_error = nullptr;
+        for (size_t i = 0; i < m_jobs.size(); i++) {
+            m_remaining[i] = m_jobs[i].dependencyCount;
+            if (m_remaining[i] == 0) {
+                roots.push_back(i);
+            }
+        }
+    }
+    for (size_t job : roots) {
+        dispatch(job);
+    }
+
+    // The main thread runs main-thread systems as they become ready and otherwise waits
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_pending > 0) {
+        if (!m_mainThreadReady.empty()) {
+            size_t job = m_mainThreadReady.front();
+            m_mainThreadReady.pop_front();
+            lock.unlock();
+            execute(job);
+            lock.lock();
+        } else {
+            m_condition.wait(lock);
+        }
+    }
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void SystemScheduler::dispatch(size_t job) {
+    if (m_jobs[job].flags & SYSTEM_MAIN_THREAD) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_mainThreadReady.push_back(job);
+        m_condition.notify_all();
+    } else {
+        m_pool.submit([this, job] { execute(job); });
+    }
+}
+
+void SystemScheduler::execute(size_t job) {
+    try {
+        m_jobs[job].run();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error) {
+            m_error = std::current_exception();
+        }
+    }
+
+    std::vector<size_t> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t dependent : m_jobs[job].dependents) {
+            if (--m_remaining[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+        m_pending--;
+        // Notify while holding the lock - once the last job is done run() may return
+        // and the scheduler may be destroyed, so nothing here may touch it afterwards
+        m_condition.notify_all();
+    }
+    for (size_t dependent : ready) {
+        dispatch(dependent);
+    }
+}
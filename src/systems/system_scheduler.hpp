@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../components/component_registry.hpp"
+#include "worker_pool.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// How a system may be scheduled, beyond its component read/write sets
+enum SystemFlags : unsigned int {
+    SYSTEM_ANY_THREAD  = 0,
+    SYSTEM_MAIN_THREAD = 1 << 0, // Touches the window, view or other main-thread-only state
+    SYSTEM_EXCLUSIVE   = 1 << 1  // Adds/destroys entities or components directly - runs with nothing else
+                                 // in flight (systems that record into an EntityCommandBuffer don't need it)
+};
+
+// Runs a scene's systems as a dependency graph
+// Each system declares the components it reads and writes (componentMask<...>()).
+// Two systems conflict when one writes a component the other reads or writes, or when
+// either is exclusive; conflicting systems run in registration order, everything else
+// may run in parallel on the worker pool.
+//
+// Scene members a system touches are not tracked - keep such state private to one
+// system, or mark the systems that share it SYSTEM_MAIN_THREAD so they never overlap.
+// Views and pools are created lazily on first use, so the first run() is serial.
+class SystemScheduler {
+public:
+    explicit SystemScheduler(WorkerPool& pool = WorkerPool::shared());
+
+    void addSystem(const std::string& name, ComponentMask reads, ComponentMask writes,
+                   std::function<void()> run, unsigned int flags = SYSTEM_ANY_THREAD);
+
+    // Run every system once and wait for all of them to finish
+    void run();
+
+    // Force serial execution in registration order (useful when debugging a race)
+    void setParallel(bool parallel) { m_parallel = parallel; }
+
+private:
+    struct Job {
+        std::string name;
+        ComponentMask reads = 0;
+        ComponentMask writes = 0;
+        unsigned int flags = SYSTEM_ANY_THREAD;
+        std::function<void()> run;
+        std::vector<size_t> dependents; // Jobs that must wait for this one
+        size_t dependencyCount = 0;
+    };
+
+    static bool conflicts(const Job& a, const Job& b);
+    void buildGraph();
+    void dispatch(size_t job);
+    void execute(size_t job);
+
+    WorkerPool& m_pool;
+    std::vector<Job> m_jobs;
+    bool m_graphDirty = true;
+    bool m_warmedUp = false;
+    bool m_parallel = true;
+
+    // Per-run state, guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<size_t> m_remaining;
+    std::deque<size_t> m_mainThreadReady;
+    size_t m_pending = 0;
+    std::exception_ptr m_error;
+};
@@ -0,0 +1,61 @@
+#include "worker_pool.hpp"
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount) {
+    threadCount = std::max<size_t>(1, threadCount);
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+size_t WorkerPool::defaultThreadCount() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool& WorkerPool::background() {
+    // Half the frame pool: searches are latency-tolerant and shouldn't crowd out systems
+    static WorkerPool pool(std::max<size_t>(1, defaultThreadCount() / 2));
+    return pool;
+}
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
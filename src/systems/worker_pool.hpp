@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads pulling tasks from a shared FIFO queue
+// Tasks must not block waiting on other tasks in the same pool
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threadCount = defaultThreadCount());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task);
+    size_t size() const { return m_threads.size(); }
+
+    // One thread per hardware core, leaving one for the main thread
+    static size_t defaultThreadCount();
+
+    // Process-wide pool shared by every scene, so scene changes don't spawn threads
+    static WorkerPool& shared();
+
+    // Process-wide pool for work that may span frames (e.g. path searches), kept apart
+    // from shared() so it never queues ahead of a frame's system tasks
+    static WorkerPool& background();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+};